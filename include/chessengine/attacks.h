@@ -0,0 +1,222 @@
+/* ************************************************************************** *
+ * Chess Engine Maat                                                          *
+ * Chess playing engine                                                       *
+ * ************************************************************************** */
+
+#ifndef CHESSENGINE_ATTACKS_H
+#define CHESSENGINE_ATTACKS_H
+
+#include "chessengine/types.h"
+
+#include <chesscore/position.h>
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <optional>
+
+namespace chessengine {
+
+/**
+ * \brief A set of squares, one bit per square.
+ *
+ * Bit 0 is square a1, bit 7 is h1, and bit 63 is h8 (the same order as
+ * chesscore::Square::index()).
+ */
+using Bitboard = std::uint64_t;
+
+/**
+ * \brief Bitboard containing a single square.
+ *
+ * \param square Index of the square.
+ * \return The bitboard.
+ */
+constexpr auto square_bit(std::size_t square) -> Bitboard {
+    return Bitboard{1} << square;
+}
+
+/**
+ * \brief Index of the lowest square in a non-empty bitboard.
+ *
+ * \param board The bitboard.
+ * \return Index of the square.
+ */
+constexpr auto lowest_square(Bitboard board) -> std::size_t {
+    return static_cast<std::size_t>(std::countr_zero(board));
+}
+
+/**
+ * \brief Squares attacked by a knight.
+ *
+ * \param square Index of the knight's square.
+ * \return The attacked squares.
+ */
+auto knight_attacks(std::size_t square) -> Bitboard;
+
+/**
+ * \brief Squares attacked by a king.
+ *
+ * \param square Index of the king's square.
+ * \return The attacked squares.
+ */
+auto king_attacks(std::size_t square) -> Bitboard;
+
+/**
+ * \brief Squares attacked by a pawn.
+ *
+ * \param color Color of the pawn.
+ * \param square Index of the pawn's square.
+ * \return The attacked squares.
+ */
+auto pawn_attacks(chesscore::Color color, std::size_t square) -> Bitboard;
+
+/**
+ * \brief Squares attacked by a bishop.
+ *
+ * The attacks along each diagonal end at the first occupied square, which is
+ * included. The attacks are looked up in a table indexed by the relevant
+ * occupied squares, either by magic multiplication or, when built with
+ * CHESSENGINE_USE_PEXT, by the BMI2 PEXT instruction.
+ * \param square Index of the bishop's square.
+ * \param occupied The occupied squares.
+ * \return The attacked squares.
+ */
+auto bishop_attacks(std::size_t square, Bitboard occupied) -> Bitboard;
+
+/**
+ * \brief Squares attacked by a rook.
+ *
+ * The attacks along each line end at the first occupied square, which is
+ * included. The attacks are looked up like the bishop attacks.
+ * \param square Index of the rook's square.
+ * \param occupied The occupied squares.
+ * \return The attacked squares.
+ */
+auto rook_attacks(std::size_t square, Bitboard occupied) -> Bitboard;
+
+/**
+ * \brief Squares strictly between two squares on a common line.
+ *
+ * \param from Index of the first square.
+ * \param to Index of the second square.
+ * \return The squares between, or an empty bitboard, if the squares are not on a common rank, file or diagonal.
+ */
+auto between_squares(std::size_t from, std::size_t to) -> Bitboard;
+
+/**
+ * \brief The complete line through two squares.
+ *
+ * \param from Index of the first square.
+ * \param to Index of the second square.
+ * \return All squares of the rank, file or diagonal through both squares, or an empty bitboard, if there is none.
+ */
+auto line_through(std::size_t from, std::size_t to) -> Bitboard;
+
+/**
+ * \brief The pieces of a position as bitboards.
+ *
+ * A snapshot of the board for computations on sets of squares, e.g. for
+ * finding all attackers of a square.
+ */
+class BoardBitboards {
+public:
+    BoardBitboards() = default;
+
+    /**
+     * \brief Collect the pieces of a position.
+     *
+     * \param position The position.
+     */
+    explicit BoardBitboards(const chesscore::Position &position);
+
+    /**
+     * \brief Put a piece on an empty square, or remove it from its square.
+     *
+     * \param piece The piece.
+     * \param square Index of the square.
+     */
+    auto toggle(chesscore::Piece piece, std::size_t square) -> void {
+        const auto bit = square_bit(square);
+        m_colors[color_index(piece.color())] ^= bit;
+        m_types[get_index(piece.type())] ^= bit;
+    }
+
+    /**
+     * \brief Squares occupied by any piece.
+     *
+     * \return The occupied squares.
+     */
+    auto occupied() const -> Bitboard { return m_colors[0] | m_colors[1]; }
+
+    /**
+     * \brief Squares occupied by the pieces of one side.
+     *
+     * \param color The side.
+     * \return The occupied squares.
+     */
+    auto pieces(chesscore::Color color) const -> Bitboard { return m_colors[color_index(color)]; }
+
+    /**
+     * \brief Squares occupied by pieces of a type (of both colors).
+     *
+     * \param type The piece type.
+     * \return The occupied squares.
+     */
+    auto pieces(chesscore::PieceType type) const -> Bitboard { return m_types[get_index(type)]; }
+
+    /**
+     * \brief Squares occupied by the pieces of one side of a type.
+     *
+     * \param color The side.
+     * \param type The piece type.
+     * \return The occupied squares.
+     */
+    auto pieces(chesscore::Color color, chesscore::PieceType type) const -> Bitboard { return pieces(color) & pieces(type); }
+
+    /**
+     * \brief The piece on a square.
+     *
+     * \param square Index of the square.
+     * \return The piece, or std::nullopt for an empty square.
+     */
+    auto piece_on(std::size_t square) const -> std::optional<chesscore::Piece>;
+
+    /**
+     * \brief All pieces of both colors attacking a square.
+     *
+     * Only pieces on occupied squares are considered and sliding pieces are
+     * blocked by occupied squares. Passing a reduced set of occupied squares
+     * reveals attackers hidden behind removed pieces (x-rays).
+     * \param square Index of the attacked square.
+     * \param occupied The occupied squares.
+     * \return The squares of the attacking pieces.
+     */
+    auto attackers_to(std::size_t square, Bitboard occupied) const -> Bitboard;
+
+    /**
+     * \brief Check, if the king of one side is attacked.
+     *
+     * \param color The side.
+     * \return If the king is in check.
+     */
+    auto in_check(chesscore::Color color) const -> bool;
+
+    auto operator==(const BoardBitboards &other) const -> bool = default;
+private:
+    std::array<Bitboard, 2> m_colors{}; ///< Squares occupied by white and black pieces.
+    std::array<Bitboard, 6> m_types{};  ///< Squares occupied by each piece type.
+};
+
+/**
+ * \brief Check, if the side to move is in check.
+ *
+ * Unlike chesscore::Position::check_state(), this does not generate the legal
+ * moves to tell a check from a checkmate.
+ * \param position The position.
+ * \return If the king of the side to move is attacked.
+ */
+auto is_in_check(const chesscore::Position &position) -> bool;
+
+} // namespace chessengine
+
+#endif
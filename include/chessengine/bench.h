@@ -0,0 +1,99 @@
+/* ************************************************************************** *
+ * Chess Engine Maat                                                          *
+ * Chess playing engine                                                       *
+ * ************************************************************************** */
+
+#ifndef CHESSENGINE_BENCH_H
+#define CHESSENGINE_BENCH_H
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace chessengine {
+
+/**
+ * \brief Settings for the benchmark.
+ */
+struct BenchConfig {
+    static constexpr int default_depth{7};                 ///< Default search depth.
+    static constexpr std::size_t default_hash_size_mb{16}; ///< Default size of the transposition table.
+
+    int depth{default_depth};                              ///< Search depth for every position.
+    std::size_t hash_size_mb{default_hash_size_mb};        ///< Size of the transposition table in megabytes.
+};
+
+/**
+ * \brief Result of the search of one benchmark position.
+ */
+struct BenchPositionResult {
+    std::string fen;                           ///< The position.
+    std::int64_t nodes{0};                     ///< Number of nodes searched.
+    std::chrono::milliseconds elapsed_time{0}; ///< Time needed for the search.
+};
+
+/**
+ * \brief Result of the benchmark.
+ */
+struct BenchResult {
+    int depth{0};                                 ///< Search depth.
+    std::vector<BenchPositionResult> positions{}; ///< Results of the single positions.
+    std::int64_t nodes{0};                        ///< Total number of nodes searched, the signature of the build.
+    std::chrono::milliseconds elapsed_time{0};    ///< Total search time.
+
+    /**
+     * \brief Compute the nodes searched per second.
+     *
+     * \return Nodes per second, if the time was measurable.
+     */
+    auto calculate_nps() const -> std::optional<std::uint64_t> {
+        const auto ms_count = elapsed_time.count();
+        if (ms_count != 0) {
+            return static_cast<std::uint64_t>(nodes * 1000 / ms_count);
+        }
+        return {};
+    }
+};
+
+/**
+ * \brief The positions of the benchmark.
+ *
+ * \return FENs of positions from all phases of the game.
+ */
+auto bench_positions() -> const std::vector<std::string> &;
+
+/**
+ * \brief Search the benchmark positions to a fixed depth.
+ *
+ * Every position is searched by a fresh engine with a single thread, so that
+ * the search neither depends on previous searches nor on the scheduling of
+ * threads. The total node count is therefore the same on every run and every
+ * machine, and changes only with changes of the search or the evaluation. It
+ * serves as signature of a build, while the nodes per second measure its
+ * speed.
+ * \param config Search depth and size of the transposition table.
+ * \return The node counts and search times.
+ */
+auto run_bench(const BenchConfig &config = {}) -> BenchResult;
+
+/**
+ * \brief Format the result of the benchmark as text.
+ *
+ * \param result The result.
+ * \return Node counts of the positions, the total nodes, time and nodes per second.
+ */
+auto to_string(const BenchResult &result) -> std::string;
+
+/**
+ * \brief Format the result of the benchmark as JSON object.
+ *
+ * \param result The result.
+ * \return The result as single-line JSON.
+ */
+auto to_json(const BenchResult &result) -> std::string;
+
+} // namespace chessengine
+
+#endif
@@ -7,32 +7,25 @@
 #define CHESS_ENGINE_CHESS_ENGINE_H
 
 #include "chessengine/config.h"
+#include "chessengine/engine_position.h"
 #include "chessengine/evaluation.h"
+#include "chessengine/mate_solver.h"
+#include "chessengine/search_worker.h"
+#include "chessengine/transposition_table.h"
 
 #include <chesscore/position.h>
 
 #include <atomic>
+#include <condition_variable>
 #include <exception>
 #include <filesystem>
+#include <memory>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 namespace chessengine {
 
-class SearchAborted : public std::runtime_error {
-public:
-    explicit SearchAborted(const std::string &message) : std::runtime_error{message} {}
-};
-
-class MoveScope {
-public:
-    explicit MoveScope(chesscore::Position &position, const chesscore::Move &move) : m_position{position}, m_move{move} { m_position.make_move(move); }
-    ~MoveScope() { m_position.unmake_move(m_move); }
-private:
-    chesscore::Position &m_position;
-    const chesscore::Move &m_move;
-};
-
 class ChessEngine {
 public:
     static const char identifier[]; ///< Name an version of the engine.
@@ -51,6 +44,11 @@ public:
      * The arguments define the stopping criteria. Set any of those values to 0
      * to disable it. If all are set to 0, the search can only be cancelled by
      * setting the stop flag (see stop_search()).
+     * The search uses as many threads as given by SearchConfig::threads. The
+     * threads share the transposition table (Lazy SMP).
+     * If StopParameters::mate_in_moves is set, the mate solver looks for a
+     * forced mate first. Only if it cannot find one, the regular search is
+     * started, limited to the depth of the requested mate.
      * \param stop_params The parameters for the stopping criteria.
      * \return The move found by the search.
      */
@@ -78,6 +76,8 @@ public:
 
     /**
      * \brief Reset internal state in preparation for a new game.
+     *
+     * Sets up the starting position and clears the transposition table.
      */
     auto new_game() -> void;
 
@@ -95,7 +95,7 @@ public:
      *
      * \return The current position.
      */
-    auto position() const -> const chesscore::Position & { return m_position; }
+    auto position() const -> const chesscore::Position & { return m_position.position(); }
 
     /**
      * \brief Play a move in the game.
@@ -159,9 +159,10 @@ public:
      * Allows to set the configuration of the engine. This includes search and
      * evaluation parameters. Setting a configuration takes effect immediately.
      * This may disturb a running search and lead to unreliable results!
+     * Changing the hash size resizes (and clears) the transposition table.
      * \param config The config.
      */
-    auto set_config(const Config &config) -> void { m_config = config; }
+    auto set_config(const Config &config) -> void;
 
     /**
      * \brief Load a configuration from a file.
@@ -174,7 +175,7 @@ public:
 private:
     Config m_config{};                                    ///< The engine configuration (search, evaluation, ...)
     Evaluator m_evaluator{m_config.evaluator_config};     ///< Evaluation of positions.
-    chesscore::Position m_position;                       ///< The current position.
+    EnginePosition m_position;                            ///< The current position.
     bool m_debugging{false};                              ///< Debugging mode.
     std::atomic<bool> m_search_running{false};            ///< If a search is running.
     std::atomic<bool> m_stop_requested{false};            ///< If the search should be stopped.
@@ -184,26 +185,61 @@ private:
     EvaluatedMove m_best_move{};                          ///< The best move found so far.
     SearchEndedCallback m_search_ended_callback{};        ///< Callback for search end.
     SearchProgressCalback m_search_progress_callback{};   ///< Callback for search progress.
-    StopParameters m_stopping_params{};                   ///< Parameters for the stopping criteria.
     std::chrono::steady_clock::time_point m_search_start; ///< Start of the search.
+    TranspositionTable m_transposition_table;             ///< Results of previous searches, shared by all search threads.
+    SearchSharedState m_shared_state;                     ///< State shared by the search threads.
+    MateSolver m_mate_solver{m_stop_requested};           ///< Proof-number search for "go mate".
+    std::vector<std::unique_ptr<SearchWorker>> m_workers; ///< The search threads; the first one is the main thread.
+    std::mutex m_timer_mutex;                             ///< Mutex for waking up the deadline timer.
+    std::condition_variable m_timer_signal;               ///< Signals the deadline timer that the search ended.
 
-    static constexpr int stop_check_interval{2048};
+    /**
+     * \brief Start a thread that stops the search at the deadline.
+     *
+     * The thread sets the shared stop flag, when the search time is up. It
+     * ends early, when the search finishes before the deadline.
+     * \param max_search_time The allowed search time.
+     * \return The timer thread (not joinable, if the search time is unlimited).
+     */
+    auto start_deadline_timer(std::chrono::milliseconds max_search_time) -> std::thread;
 
     /**
-     * \brief Checks, if a running search should be stopped.
+     * \brief Search for a forced mate with the mate solver.
      *
-     * There might be different reasons why a search should stop as soon as
-     * possible. These include a request by the user or timing constraints.
-     * If the search should be stopped, the function throws a SearchAborted
-     * exception.
+     * On success, the best move and the search statistics are set.
+     * \param stop_params The parameters for the stopping criteria.
+     * \return If a mate was found.
      */
-    auto check_stop() const -> void;
+    auto solve_mate(const StopParameters &stop_params) -> bool;
 
-    auto search_position(Depth depth) -> EvaluatedMove;
-    auto search_position(Depth depth, Bounds bounds) -> Score;
-    auto moves_to_search(bool search_principal_variation_first = false) const -> chesscore::MoveList;
+    /**
+     * \brief Finish a search and announce the best move.
+     *
+     * \return The best move found.
+     */
+    auto finish_search() -> EvaluatedMove;
+
+    /**
+     * \brief Create or remove workers to match the configured thread count.
+     */
+    auto prepare_workers() -> void;
+
+    /**
+     * \brief Report the progress of the search.
+     *
+     * Called by the main worker after each completed iteration and when an
+     * iteration fails outside of its aspiration window.
+     * \param worker_stats Statistics of the main worker.
+     */
+    auto report_progress(const SearchStats &worker_stats) -> void;
 
-    auto sort_moves(chesscore::MoveList &moves) const -> void;
+    /**
+     * \brief Combine the results of all workers after a search.
+     *
+     * The best move is taken from the worker that completed the deepest
+     * iteration, preferring the main worker. Node counts are summed up.
+     */
+    auto collect_results() -> void;
 };
 
 } // namespace chessengine
@@ -6,6 +6,7 @@
 #ifndef CHESSENGINE_CONFIG_H
 #define CHESSENGINE_CONFIG_H
 
+#include <algorithm>
 #include <array>
 #include <filesystem>
 
@@ -17,16 +18,48 @@ namespace chessengine {
  * \brief Configuration parameters for the search algorithm.
  */
 struct MinimaxConfig {
-    bool use_alpha_beta_pruning{true}; ///< If alpha-beta-pruning should be applied.
-    bool use_move_ordering{true};      ///< If move ordering should be used.
+    bool use_alpha_beta_pruning{true};            ///< If alpha-beta-pruning should be applied.
+    bool use_move_ordering{true};                 ///< If move ordering should be used.
+    bool use_move_history{true};                  ///< If killer moves, countermoves and the history heuristic should be used for ordering quiet moves.
+    bool use_transposition_table{true};           ///< If search results should be stored in and taken from the transposition table.
+    bool use_eval_cache{true};                    ///< If static evaluations should be stored in and taken from the evaluation cache.
+    bool use_principal_variation_search{true};    ///< If moves after the first should be searched with a zero window.
+    bool use_quiescence_search{true};             ///< If captures and promotions should be searched beyond the nominal depth.
+    bool use_delta_pruning{true};                 ///< If captures that cannot raise alpha should be skipped in quiescence search.
+    Score delta_pruning_margin{200};              ///< Safety margin for delta pruning.
+    bool use_null_move_pruning{true};             ///< If nodes should be pruned, when passing the move still fails high.
+    Depth null_move_min_depth{3};                 ///< Minimum remaining depth for trying a null move.
+    Depth null_move_verification_depth{8};        ///< Minimum remaining depth for verifying a null move cutoff with a reduced search.
+    bool use_late_move_reductions{true};          ///< If quiet moves late in the move order should be searched with reduced depth.
+    Depth late_move_reduction_min_depth{3};       ///< Minimum remaining depth for reducing moves.
+    std::size_t late_move_reduction_min_moves{3}; ///< Number of moves searched without reduction in each node.
+    Depth shallow_pruning_max_depth{3};           ///< Maximum remaining depth for reverse futility pruning, razoring, futility pruning and late move pruning.
+    bool use_reverse_futility_pruning{true};      ///< If nodes should be cut off, when the static evaluation exceeds beta by a margin.
+    Score reverse_futility_margin{120};           ///< Margin for reverse futility pruning per ply of remaining depth.
+    bool use_razoring{true};                      ///< If nodes far below alpha should be resolved by quiescence search.
+    Score razoring_margin{300};                   ///< Margin for razoring per ply of remaining depth.
+    bool use_futility_pruning{true};              ///< If quiet moves should be skipped, when the static evaluation is below alpha by a margin.
+    Score futility_margin{150};                   ///< Margin for futility pruning per ply of remaining depth.
+    bool use_late_move_pruning{true};             ///< If quiet moves late in the move order should be skipped.
+    std::size_t late_move_pruning_base{3};        ///< Number of moves searched at depth 0 before late move pruning; grows by depth squared.
+    bool use_see_pruning{true};                   ///< If captures losing material in the static exchange evaluation should be skipped near the horizon and in quiescence search.
+    Score see_pruning_margin{100};                ///< Material that a capture may lose per ply of remaining depth, before it is skipped.
+    bool use_check_extensions{true};              ///< If moves giving check should be searched one ply deeper.
+    std::size_t max_check_extensions{8};          ///< Maximum number of check extensions on a path from the root.
+    bool use_mate_distance_pruning{true};         ///< If the search window should be limited to scores that can beat the shortest mate.
 };
 
 /**
  * \brief Configuration parameters for the search strategy.
  */
 struct SearchConfig {
-    bool iterative_deepening{false}; ///< If iterative deepening should be used.
-    bool search_pv_first{true};      ///< If the principal variation from the previous iteration should be searched first.
+    bool iterative_deepening{false};   ///< If iterative deepening should be used.
+    bool search_pv_first{true};        ///< If the principal variation from the previous iteration should be searched first.
+    std::size_t hash_size_mb{16};      ///< Size of the transposition table in megabytes.
+    std::size_t eval_cache_size_mb{2}; ///< Size of the evaluation cache of each search thread in megabytes, 0 switches the cache off.
+    std::size_t threads{1};            ///< Number of threads searching in parallel.
+    bool use_aspiration_windows{true}; ///< If iterations should start with a narrow window around the score of the previous iteration.
+    Score aspiration_window{25};       ///< Initial distance of the aspiration window bounds from the previous score.
 };
 
 /**
@@ -59,6 +92,14 @@ struct PieceSquareTable {
     auto value(const chesscore::Square &square) -> Score & { return values[square.index()]; }
 };
 
+/**
+ * \brief A score with separate values for the middlegame and the endgame.
+ */
+struct TaperedScore {
+    Score middlegame{0}; ///< Value in the middlegame.
+    Score endgame{0};    ///< Value in the endgame.
+};
+
 /**
  * \brief Configuration for the evaluator.
  *
@@ -67,10 +108,15 @@ struct PieceSquareTable {
  */
 class EvaluatorConfig {
 public:
+    static constexpr int max_game_phase{24}; ///< Game phase of the initial position, blending fully into the middlegame values.
+
     bool use_material_balance{true};    ///< Count material balance in position evaluation.
     bool use_piece_square_tables{true}; ///< Use piece-square tables in position and move evaluation.
     bool use_promotion_bonus{true};     ///< Use additional bonus for pawn promotions in move evaluation.
     bool use_capture_bonus{false};      ///< Use additional bonus for captures in move evaluation.
+    bool use_pawn_structure{true};      ///< Evaluate doubled, isolated, backward and passed pawns and the pawns sheltering the king.
+    bool use_material_imbalance{true};  ///< Evaluate the bishop pair and the value of knights and rooks depending on the number of pawns.
+    bool use_endgame_knowledge{true};   ///< Recognize drawn material and evaluate endgames against a lone king specially.
 
     /**
      * \brief The scores for each piece type.
@@ -81,12 +127,21 @@ public:
     Score piece_values[6]{Score{100}, Score{300}, Score{300}, Score{500}, Score{900}, Score{0}};
 
     /**
-     * \brief Scores for a piece on a square.
+     * \brief Weights of the piece types for the game phase.
+     *
+     * The game phase is the sum of the weights of all pieces on the board,
+     * limited to max_game_phase. It decreases from the opening to the endgame
+     * and blends the middlegame and endgame piece-square tables.
+     */
+    int phase_weights[6]{0, 1, 1, 2, 4, 0};
+
+    /**
+     * \brief Scores for a piece on a square in the middlegame.
      *
      * The tables are defined from the perspective of the white player. For
      * black, the ranks have to be mirrored.
      */
-    PieceSquareTable piece_square_tables[7]{
+    PieceSquareTable piece_square_tables[6]{
         // clang-format off
         // Pawn
         {
@@ -143,7 +198,7 @@ public:
             Score{-10}, Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{-10},
             Score{-20}, Score{-10}, Score{-10}, Score{ -5}, Score{ -5}, Score{-10}, Score{-10}, Score{-20}
         }, 
-        // King (middle game)
+        // King
         {
             Score{ 20}, Score{ 30}, Score{ 10}, Score{  0}, Score{  0}, Score{ 10}, Score{ 30}, Score{ 20},
             Score{ 20}, Score{ 20}, Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{ 20}, Score{ 20},
@@ -153,8 +208,74 @@ public:
             Score{-30}, Score{-40}, Score{-40}, Score{-50}, Score{-50}, Score{-40}, Score{-40}, Score{-30},
             Score{-30}, Score{-40}, Score{-40}, Score{-50}, Score{-50}, Score{-40}, Score{-40}, Score{-30},
             Score{-30}, Score{-40}, Score{-40}, Score{-50}, Score{-50}, Score{-40}, Score{-40}, Score{-30}
+        }
+        // clang-format on
+    };
+
+    /**
+     * \brief Scores for a piece on a square in the endgame.
+     *
+     * Like piece_square_tables, but used, when only few pieces are left. Pawns
+     * gain by advancing, the king by centralizing.
+     */
+    PieceSquareTable endgame_piece_square_tables[6]{
+        // clang-format off
+        // Pawn
+        {
+            Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{  0},
+            Score{ 10}, Score{ 10}, Score{ 10}, Score{ 10}, Score{ 10}, Score{ 10}, Score{ 10}, Score{ 10},
+            Score{ 10}, Score{ 10}, Score{ 10}, Score{ 10}, Score{ 10}, Score{ 10}, Score{ 10}, Score{ 10},
+            Score{ 20}, Score{ 20}, Score{ 20}, Score{ 20}, Score{ 20}, Score{ 20}, Score{ 20}, Score{ 20},
+            Score{ 30}, Score{ 30}, Score{ 30}, Score{ 30}, Score{ 30}, Score{ 30}, Score{ 30}, Score{ 30},
+            Score{ 50}, Score{ 50}, Score{ 50}, Score{ 50}, Score{ 50}, Score{ 50}, Score{ 50}, Score{ 50},
+            Score{ 80}, Score{ 80}, Score{ 80}, Score{ 80}, Score{ 80}, Score{ 80}, Score{ 80}, Score{ 80},
+            Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{  0}
         },
-        // King (end game)
+        // Knight
+        {
+            Score{-50}, Score{-40}, Score{-30}, Score{-30}, Score{-30}, Score{-30}, Score{-40}, Score{-50},
+            Score{-40}, Score{-20}, Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{-20}, Score{-40},
+            Score{-30}, Score{  0}, Score{ 10}, Score{ 15}, Score{ 15}, Score{ 10}, Score{  0}, Score{-30},
+            Score{-30}, Score{  0}, Score{ 15}, Score{ 20}, Score{ 20}, Score{ 15}, Score{  0}, Score{-30},
+            Score{-30}, Score{  0}, Score{ 15}, Score{ 20}, Score{ 20}, Score{ 15}, Score{  0}, Score{-30},
+            Score{-30}, Score{  0}, Score{ 10}, Score{ 15}, Score{ 15}, Score{ 10}, Score{  0}, Score{-30},
+            Score{-40}, Score{-20}, Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{-20}, Score{-40},
+            Score{-50}, Score{-40}, Score{-30}, Score{-30}, Score{-30}, Score{-30}, Score{-40}, Score{-50}
+        },
+        // Bishop
+        {
+            Score{-20}, Score{-10}, Score{-10}, Score{-10}, Score{-10}, Score{-10}, Score{-10}, Score{-20},
+            Score{-10}, Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{-10},
+            Score{-10}, Score{  0}, Score{  5}, Score{ 10}, Score{ 10}, Score{  5}, Score{  0}, Score{-10},
+            Score{-10}, Score{  0}, Score{ 10}, Score{ 10}, Score{ 10}, Score{ 10}, Score{  0}, Score{-10},
+            Score{-10}, Score{  0}, Score{ 10}, Score{ 10}, Score{ 10}, Score{ 10}, Score{  0}, Score{-10},
+            Score{-10}, Score{  0}, Score{  5}, Score{ 10}, Score{ 10}, Score{  5}, Score{  0}, Score{-10},
+            Score{-10}, Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{-10},
+            Score{-20}, Score{-10}, Score{-10}, Score{-10}, Score{-10}, Score{-10}, Score{-10}, Score{-20}
+        },
+        // Rook
+        {
+            Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{  0},
+            Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{  0},
+            Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{  0},
+            Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{  0},
+            Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{  0},
+            Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{  0},
+            Score{ 10}, Score{ 10}, Score{ 10}, Score{ 10}, Score{ 10}, Score{ 10}, Score{ 10}, Score{ 10},
+            Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{  0}
+        },
+        // Queen
+        {
+            Score{-20}, Score{-10}, Score{-10}, Score{ -5}, Score{ -5}, Score{-10}, Score{-10}, Score{-20},
+            Score{-10}, Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{-10},
+            Score{-10}, Score{  0}, Score{  5}, Score{  5}, Score{  5}, Score{  5}, Score{  0}, Score{-10},
+            Score{ -5}, Score{  0}, Score{  5}, Score{ 10}, Score{ 10}, Score{  5}, Score{  0}, Score{ -5},
+            Score{ -5}, Score{  0}, Score{  5}, Score{ 10}, Score{ 10}, Score{  5}, Score{  0}, Score{ -5},
+            Score{-10}, Score{  0}, Score{  5}, Score{  5}, Score{  5}, Score{  5}, Score{  0}, Score{-10},
+            Score{-10}, Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{-10},
+            Score{-20}, Score{-10}, Score{-10}, Score{ -5}, Score{ -5}, Score{-10}, Score{-10}, Score{-20}
+        },
+        // King
         {
             Score{-50}, Score{-30}, Score{-30}, Score{-30}, Score{-30}, Score{-30}, Score{-30}, Score{-50},
             Score{-30}, Score{-30}, Score{  0}, Score{  0}, Score{  0}, Score{  0}, Score{-30}, Score{-30},
@@ -170,6 +291,32 @@ public:
 
     Score pawn_promotion_score{100}; ///< Bonus for a promoting pawn.
 
+    TaperedScore doubled_pawn{Score{-10}, Score{-20}};  ///< Penalty for a pawn behind another pawn of the same color.
+    TaperedScore isolated_pawn{Score{-10}, Score{-15}}; ///< Penalty for a pawn without pawns of the same color on the adjacent files.
+    TaperedScore backward_pawn{Score{-8}, Score{-10}};  ///< Penalty for a pawn behind the pawns on the adjacent files, that cannot advance safely.
+    Score king_shelter_pawn{10};                        ///< Middlegame bonus for each pawn on the king's and the adjacent files, one or two ranks in front of the king.
+
+    TaperedScore bishop_pair{Score{30}, Score{50}}; ///< Bonus for having two or more bishops.
+    Score knight_pawn_adjustment{6};                ///< Change of a knight's value for each own pawn more than five.
+    Score rook_pawn_adjustment{-12};                ///< Change of a rook's value for each own pawn more than five.
+
+    /**
+     * \brief Bonus for a passed pawn.
+     *
+     * Indexed by the rank of the pawn, seen from the pawn's side (i.e., the
+     * second rank is the initial rank of the pawns).
+     */
+    std::array<TaperedScore, 8> passed_pawn{{
+        {Score{0}, Score{0}},
+        {Score{5}, Score{10}},
+        {Score{5}, Score{15}},
+        {Score{10}, Score{25}},
+        {Score{20}, Score{45}},
+        {Score{35}, Score{75}},
+        {Score{60}, Score{120}},
+        {Score{0}, Score{0}},
+    }};
+
     /**
      * \brief Get the value for a piece of a given type.
      *
@@ -179,11 +326,8 @@ public:
     auto piece_value(chesscore::PieceType piece_type) const -> Score { return piece_values[get_index(piece_type)]; }
 
     /**
-     * \brief Gives the value for a piece on a square.
+     * \brief Gives the middlegame value for a piece on a square.
      *
-     * Values for the king should be used during middle game. For the end game,
-     * use king_on_square_value(), which can interpolate between middle game and
-     * end game values.
      * \param piece The piece.
      * \param square The square.
      * \return The value for the given piece on the given square.
@@ -194,23 +338,39 @@ public:
     }
 
     /**
-     * \brief Evaluate the kings position on the board.
+     * \brief Gives the endgame value for a piece on a square.
+     *
+     * \param piece The piece.
+     * \param square The square.
+     * \return The value for the given piece on the given square.
+     */
+    auto piece_on_square_endgame_value(chesscore::Piece piece, const chesscore::Square &square) const -> Score {
+        const auto lookup_square = (piece.color() == chesscore::Color::White) ? square : square.mirrored();
+        return endgame_piece_square_tables[get_index(piece.type())].value(lookup_square);
+    }
+
+    /**
+     * \brief Get the weight of a piece type for the game phase.
+     *
+     * \param piece_type Type of the piece.
+     * \return Weight of a piece of the given type.
+     */
+    auto phase_weight(chesscore::PieceType piece_type) const -> int { return phase_weights[get_index(piece_type)]; }
+
+    /**
+     * \brief Blend a middlegame and an endgame score by the game phase.
      *
-     * Returns the value for the kings position on the board. Can interpolate
-     * between tables for middle game and end game. The tables are weighted with
-     * the given factor. A factor of 1.0 means middle game, a factor of 0.0
-     * means end game. Factors in between mix the values for the tables
-     * accordingly.
-     * \param square The square where the king is.
-     * \param color Color of the king.
-     * \param middlegame_factor Factor for weighting the middle game table vs. end game table (1.0 -> middle game; 0.0 -> end game).
-     * \return Value for the king on the given square.
+     * Interpolates linearly with integers only, from the endgame score at
+     * phase 0 to the middlegame score at max_game_phase.
+     * \param middlegame The middlegame score.
+     * \param endgame The endgame score.
+     * \param phase The game phase, larger values are limited to max_game_phase.
+     * \return The blended score.
      */
-    auto king_on_square_value(const chesscore::Square &square, chesscore::Color color, float middlegame_factor = 1.0F) const -> Score {
-        const auto lookup_square = color == chesscore::Color::White ? square : square.mirrored();
-        const auto middlegame_value = piece_square_tables[6].value(lookup_square).value;
-        const auto endgame_value = piece_square_tables[7].value(lookup_square).value;
-        return Score{static_cast<Score::value_type>(middlegame_value * middlegame_factor + endgame_value * (1.0F - middlegame_factor))};
+    static constexpr auto tapered(Score middlegame, Score endgame, int phase) -> Score {
+        const auto middlegame_weight = std::min(phase, max_game_phase);
+        const auto blended = (middlegame.value * middlegame_weight + endgame.value * (max_game_phase - middlegame_weight)) / max_game_phase;
+        return Score{static_cast<Score::value_type>(blended)};
     }
 
     auto empty_board_value() const -> Score { return Score{0}; }
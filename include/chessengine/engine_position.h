@@ -0,0 +1,261 @@
+/* ************************************************************************** *
+ * Chess Engine Maat                                                          *
+ * Chess playing engine                                                       *
+ * ************************************************************************** */
+
+#ifndef CHESSENGINE_ENGINE_POSITION_H
+#define CHESSENGINE_ENGINE_POSITION_H
+
+#include "chessengine/attacks.h"
+#include "chessengine/eval_accumulator.h"
+#include "chessengine/zobrist.h"
+
+#include <chesscore/position.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace chessengine {
+
+/**
+ * \brief A chess position together with state maintained by the engine.
+ *
+ * Wraps a chesscore::Position and keeps additional information, that is
+ * updated incrementally while moves are made and unmade during the search.
+ * This is the Zobrist key of the position, the keys of its pawns and of its
+ * material, the pieces as bitboards for the move generator, the evaluation
+ * terms and the state needed for draw detection. The keys of all positions
+ * since the last set_position() are kept on a stack, so the moves of the game
+ * and the moves of the search path are checked for repetitions alike.
+ *
+ * chesscore has no null moves. While a null move is played, the wrapped
+ * position is left at the position before the null move and all moves are
+ * only applied to the engine state.
+ */
+class EnginePosition {
+public:
+    static constexpr std::uint8_t white_kingside{1U};  ///< White may castle kingside.
+    static constexpr std::uint8_t white_queenside{2U}; ///< White may castle queenside.
+    static constexpr std::uint8_t black_kingside{4U};  ///< Black may castle kingside.
+    static constexpr std::uint8_t black_queenside{8U}; ///< Black may castle queenside.
+
+    EnginePosition() : EnginePosition{chesscore::Position{}} {}
+    explicit EnginePosition(const chesscore::Position &position) { set_position(position); }
+
+    /**
+     * \brief Set up a new position.
+     *
+     * All engine state is computed from scratch.
+     * \param position The position.
+     */
+    auto set_position(const chesscore::Position &position) -> void;
+
+    /**
+     * \brief The wrapped position.
+     *
+     * While a null move is played, this is the position before the null move.
+     * \return The position.
+     */
+    auto position() const -> const chesscore::Position & { return m_position; }
+
+    /**
+     * \brief The player to make the next move.
+     *
+     * \return Color of the side to move.
+     */
+    auto side_to_move() const -> chesscore::Color { return m_state.side_to_move; }
+
+    /**
+     * \brief Zobrist key of the position.
+     *
+     * \return The key.
+     */
+    auto key() const -> HashKey { return m_state.key; }
+
+    /**
+     * \brief Zobrist key of the pawns of the position.
+     *
+     * Only contains the keys of the pawns on their squares, so that positions
+     * with the same pawn structure share the key.
+     * \return The pawn key.
+     */
+    auto pawn_key() const -> HashKey { return m_state.pawn_key; }
+
+    /**
+     * \brief Zobrist key of the material of the position.
+     *
+     * Only depends on the number of pieces of each kind, not on their squares.
+     * \return The material key.
+     */
+    auto material_key() const -> HashKey { return m_state.material_key; }
+
+    /**
+     * \brief The pieces of the position as bitboards.
+     *
+     * \return The bitboards.
+     */
+    auto board() const -> const BoardBitboards & { return m_state.board; }
+
+    /**
+     * \brief Maintain the evaluation terms with the given values.
+     *
+     * The terms of the current position and of all positions on the stack are
+     * computed from scratch. Afterwards, they are updated with every move.
+     * Without values, the terms are not maintained.
+     * \param values The precomputed values of the evaluator, nullptr to stop maintaining the terms.
+     */
+    auto set_piece_square_values(const PieceSquareValues *values) -> void;
+
+    /**
+     * \brief The evaluation terms of the position.
+     *
+     * Only maintained, if piece-square values were set.
+     * \return Material and piece-square sums of both colors.
+     */
+    auto evaluation_terms() const -> const EvalAccumulator & { return m_state.eval; }
+
+    /**
+     * \brief The castling rights.
+     *
+     * \return Bit set of white_kingside, white_queenside, black_kingside and black_queenside.
+     */
+    auto castling_rights() const -> std::uint8_t { return m_state.castling; }
+
+    /**
+     * \brief File of the en-passant target square.
+     *
+     * The target is only set, if a pawn of the side to move can capture en
+     * passant (ignoring pins).
+     * \return The file, or -1, if no en-passant capture is possible.
+     */
+    auto en_passant_file() const -> int { return m_state.en_passant; }
+
+    /**
+     * \brief Check, if the side to move is in check.
+     *
+     * \return If the king of the side to move is attacked.
+     */
+    auto in_check() const -> bool { return m_state.board.in_check(side_to_move()); }
+
+    /**
+     * \brief Number of plies since the last capture or pawn move.
+     *
+     * \return The halfmove clock for the fifty-move rule.
+     */
+    auto halfmove_clock() const -> int { return m_state.halfmove_clock; }
+
+    /**
+     * \brief Check, if the position occurred before.
+     *
+     * Only positions with the same side to move since the last irreversible
+     * move (capture, pawn move or null move) are compared, as no position
+     * before can be repeated.
+     * \return If the position is a repetition.
+     */
+    auto is_repetition() const -> bool;
+
+    /**
+     * \brief Check, if the position is a draw by repetition or the fifty-move rule.
+     *
+     * A single repetition is enough to score the position as a draw, as the
+     * side that repeated could repeat again.
+     * \return If the position is a draw.
+     */
+    auto is_draw() const -> bool;
+
+    /**
+     * \brief Play a move.
+     *
+     * Makes the move on the wrapped position and updates the engine state
+     * incrementally. The move has to be legal in the current position.
+     * \param move The move.
+     */
+    auto make_move(const chesscore::Move &move) -> void;
+
+    /**
+     * \brief Take back a move.
+     *
+     * The move has to be the last move made by make_move().
+     * \param move The move.
+     */
+    auto unmake_move(const chesscore::Move &move) -> void;
+
+    /**
+     * \brief Pass the move to the opponent.
+     *
+     * A null move only changes the side to move and clears the en-passant
+     * target. It is not a legal chess move and only used by the search.
+     */
+    auto make_null_move() -> void;
+
+    /**
+     * \brief Take back a null move.
+     *
+     * The null move has to be the last move made.
+     */
+    auto unmake_null_move() -> void;
+
+    /**
+     * \brief Check, if a null move is played.
+     *
+     * \return If a null move has been made and not taken back.
+     */
+    auto in_null_move() const -> bool { return m_null_moves > 0; }
+private:
+    /**
+     * \brief State that has to be restored when a move is taken back.
+     */
+    struct State {
+        HashKey key{0};                                         ///< Zobrist key of the position.
+        HashKey pawn_key{0};                                    ///< Zobrist key of the pawns.
+        HashKey material_key{0};                                ///< Zobrist key of the number of pieces of each kind.
+        BoardBitboards board{};                                 ///< The pieces as bitboards.
+        EvalAccumulator eval{};                                 ///< Evaluation terms of the pieces.
+        std::uint8_t castling{0};                               ///< Castling rights as bit set.
+        std::int8_t en_passant{-1};                             ///< File of a capturable en-passant target, -1 for none.
+        std::uint16_t halfmove_clock{0};                        ///< Plies since the last capture or pawn move.
+        std::uint16_t reversible_plies{0};                      ///< Plies since the last irreversible move, including null moves.
+        chesscore::Color side_to_move{chesscore::Color::White}; ///< The player to make the next move.
+    };
+
+    chesscore::Position m_position;                             ///< The position.
+    State m_state{};                                            ///< Current state.
+    std::vector<State> m_history;                               ///< States before each move made, the key history for repetitions.
+    std::size_t m_null_moves{0};                                ///< Number of null moves made and not taken back.
+    const PieceSquareValues *m_piece_square_values{nullptr};    ///< Values for the evaluation terms, nullptr if they are not maintained.
+
+    auto toggle_piece(chesscore::Piece piece, const chesscore::Square &square) -> void;
+    auto set_castling(std::uint8_t castling) -> void;
+    auto set_en_passant(std::int8_t file) -> void;
+    auto en_passant_capturable(int file) const -> bool;
+    auto compute_evaluation_terms(const BoardBitboards &board) const -> EvalAccumulator;
+};
+
+/**
+ * \brief Makes a move for the lifetime of the scope.
+ *
+ * The move is made on construction and taken back on destruction.
+ */
+class MoveScope {
+public:
+    explicit MoveScope(EnginePosition &position, const chesscore::Move &move) : m_position{position}, m_move{move} { m_position.make_move(move); }
+    ~MoveScope() { m_position.unmake_move(m_move); }
+private:
+    EnginePosition &m_position;
+    const chesscore::Move &m_move;
+};
+
+/**
+ * \brief Makes a null move for the lifetime of the scope.
+ */
+class NullMoveScope {
+public:
+    explicit NullMoveScope(EnginePosition &position) : m_position{position} { m_position.make_null_move(); }
+    ~NullMoveScope() { m_position.unmake_null_move(); }
+private:
+    EnginePosition &m_position;
+};
+
+} // namespace chessengine
+
+#endif
@@ -0,0 +1,115 @@
+/* ************************************************************************** *
+ * Chess Engine Maat                                                          *
+ * Chess playing engine                                                       *
+ * ************************************************************************** */
+
+#ifndef CHESSENGINE_EVAL_ACCUMULATOR_H
+#define CHESSENGINE_EVAL_ACCUMULATOR_H
+
+#include "chessengine/config.h"
+#include "chessengine/types.h"
+
+#include <array>
+#include <cstddef>
+
+namespace chessengine {
+
+/**
+ * \brief Material and piece-square values of all pieces on all squares.
+ *
+ * The values are looked up from an EvaluatorConfig once, including the
+ * mirroring of the squares for black, so that updating the evaluation terms
+ * for a moving piece is a plain table lookup.
+ */
+class PieceSquareValues {
+public:
+    PieceSquareValues() = default;
+
+    /**
+     * \brief Precompute the values of an evaluator configuration.
+     *
+     * \param config The configuration.
+     */
+    explicit PieceSquareValues(const EvaluatorConfig &config);
+
+    /**
+     * \brief Material value of a piece.
+     *
+     * \param piece The piece.
+     * \return Value of the piece.
+     */
+    auto material(chesscore::Piece piece) const -> Score { return m_material[piece_index(piece)]; }
+
+    /**
+     * \brief Middlegame piece-square value of a piece on a square.
+     *
+     * \param piece The piece.
+     * \param square Index of the square.
+     * \return Value of the piece on the square.
+     */
+    auto middlegame(chesscore::Piece piece, std::size_t square) const -> Score { return m_middlegame[piece_index(piece)][square]; }
+
+    /**
+     * \brief Endgame piece-square value of a piece on a square.
+     *
+     * \param piece The piece.
+     * \param square Index of the square.
+     * \return Value of the piece on the square.
+     */
+    auto endgame(chesscore::Piece piece, std::size_t square) const -> Score { return m_endgame[piece_index(piece)][square]; }
+private:
+    using SquareValues = std::array<std::array<Score, chesscore::Square::count>, piece_index_count>;
+
+    std::array<Score, piece_index_count> m_material{}; ///< Material values by piece index.
+    SquareValues m_middlegame{};                       ///< Middlegame piece-square values by piece index and square.
+    SquareValues m_endgame{};                          ///< Endgame piece-square values by piece index and square.
+};
+
+/**
+ * \brief Evaluation terms of a position, that are updated with every move.
+ *
+ * Holds the sum of the material values and the sums of the middlegame and
+ * endgame piece-square values of the pieces of each color. The position adds
+ * and removes pieces while making a move, and restores the previous terms,
+ * when the move is taken back. The static evaluation does not need to look at
+ * the board.
+ */
+struct EvalAccumulator {
+    std::array<Score, 2> material{Score{0}, Score{0}};   ///< Material of white and black.
+    std::array<Score, 2> middlegame{Score{0}, Score{0}}; ///< Middlegame piece-square values of white and black.
+    std::array<Score, 2> endgame{Score{0}, Score{0}};    ///< Endgame piece-square values of white and black.
+
+    /**
+     * \brief Add a piece to the terms.
+     *
+     * \param values The precomputed values.
+     * \param piece The piece.
+     * \param square Index of the square of the piece.
+     */
+    auto add(const PieceSquareValues &values, chesscore::Piece piece, std::size_t square) -> void {
+        const auto color = color_index(piece.color());
+        material[color] += values.material(piece);
+        middlegame[color] += values.middlegame(piece, square);
+        endgame[color] += values.endgame(piece, square);
+    }
+
+    /**
+     * \brief Remove a piece from the terms.
+     *
+     * \param values The precomputed values.
+     * \param piece The piece.
+     * \param square Index of the square of the piece.
+     */
+    auto remove(const PieceSquareValues &values, chesscore::Piece piece, std::size_t square) -> void {
+        const auto color = color_index(piece.color());
+        material[color] -= values.material(piece);
+        middlegame[color] -= values.middlegame(piece, square);
+        endgame[color] -= values.endgame(piece, square);
+    }
+
+    auto operator==(const EvalAccumulator &other) const -> bool = default;
+};
+
+} // namespace chessengine
+
+#endif
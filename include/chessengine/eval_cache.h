@@ -0,0 +1,97 @@
+/* ************************************************************************** *
+ * Chess Engine Maat                                                          *
+ * Chess playing engine                                                       *
+ * ************************************************************************** */
+
+#ifndef CHESSENGINE_EVAL_CACHE_H
+#define CHESSENGINE_EVAL_CACHE_H
+
+#include "chessengine/types.h"
+#include "chessengine/zobrist.h"
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+namespace chessengine {
+
+/**
+ * \brief Cache for static evaluations of positions.
+ *
+ * Transpositions and the stand-pat scores of the quiescence search evaluate
+ * the same positions again and again. The cache is indexed by the Zobrist key
+ * of the position and always overwrites the entry in its slot. The score is
+ * for the side to move, which is part of the key.
+ *
+ * Each entry is a single word holding the upper bits of the key and the
+ * score, so that an entry is always read and written as a whole. Each search
+ * thread has its own cache.
+ */
+class EvalCache {
+public:
+    static constexpr std::size_t default_size_mb{2}; ///< Default size of the cache in megabytes.
+
+    explicit EvalCache(std::size_t size_mb = default_size_mb) { resize(size_mb); }
+
+    /**
+     * \brief Change the size of the cache.
+     *
+     * The number of entries is the largest power of two, that fits into the
+     * given size. The cache is cleared. A size of 0 releases the entries; the
+     * cache must not be used then.
+     * \param size_mb Size of the cache in megabytes.
+     */
+    auto resize(std::size_t size_mb) -> void;
+
+    /**
+     * \brief Size of the cache in megabytes.
+     *
+     * \return The size given with the last resize.
+     */
+    auto size_mb() const -> std::size_t { return m_size_mb; }
+
+    /**
+     * \brief Check, if the cache has no entries.
+     *
+     * \return If the cache was resized to 0.
+     */
+    auto empty() const -> bool { return m_entry_count == 0; }
+
+    /**
+     * \brief Remove all entries.
+     */
+    auto clear() -> void;
+
+    /**
+     * \brief Look up the evaluation of a position.
+     *
+     * \param key Zobrist key of the position.
+     * \return The stored score, if the position is in the cache.
+     */
+    auto probe(HashKey key) const -> std::optional<Score> {
+        const auto entry = m_entries[key & m_index_mask];
+        if ((entry & key_mask) != (key & key_mask)) {
+            return std::nullopt;
+        }
+        return Score{static_cast<Score::value_type>(static_cast<std::uint16_t>(entry))};
+    }
+
+    /**
+     * \brief Store the evaluation of a position.
+     *
+     * \param key Zobrist key of the position.
+     * \param score The static evaluation for the side to move.
+     */
+    auto store(HashKey key, Score score) -> void { m_entries[key & m_index_mask] = (key & key_mask) | static_cast<std::uint16_t>(score.value); }
+private:
+    static constexpr std::uint64_t key_mask{~std::uint64_t{0xFFFF}}; ///< Bits of the key stored with the score.
+
+    std::unique_ptr<std::uint64_t[]> m_entries; ///< Key bits and score.
+    std::size_t m_entry_count{0};               ///< Number of entries, a power of two or 0.
+    std::size_t m_index_mask{0};                ///< Number of entries minus one.
+    std::size_t m_size_mb{0};                   ///< Size given with the last resize.
+};
+
+} // namespace chessengine
+
+#endif
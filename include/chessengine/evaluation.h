@@ -8,7 +8,12 @@
 
 #include <chesscore/position.h>
 
+#include "chessengine/attacks.h"
 #include "chessengine/config.h"
+#include "chessengine/engine_position.h"
+#include "chessengine/eval_accumulator.h"
+#include "chessengine/material_hash_table.h"
+#include "chessengine/pawn_hash_table.h"
 #include "chessengine/types.h"
 
 namespace chessengine {
@@ -16,18 +21,119 @@ namespace chessengine {
 class Evaluator {
 public:
     Evaluator() = default;
-    explicit Evaluator(EvaluatorConfig config) : m_config{std::move(config)} {}
+    explicit Evaluator(EvaluatorConfig config) : m_config{std::move(config)}, m_piece_square_values{m_config} {}
 
     /**
      * \brief Evaluate a position.
      *
      * Evaluates a given position from the perspective of the given player.
+     * Checkmate and stalemate are recognized, which needs a legal move
+     * generation. The search knows, if there are legal moves, and uses
+     * static_evaluation() and terminal_score() instead.
      * \param position The position to evaluate.
      * \param color The player whose perspective is used for evaluation.
      * \return The position's score.
      */
     auto evaluate(const chesscore::Position &position, chesscore::Color color) const -> Score;
 
+    /**
+     * \brief Evaluate a position without looking for mate or stalemate.
+     *
+     * The score is the difference of the material and of the piece-square
+     * values of both players, so that the score for one player is the negated
+     * score for the other player. The piece-square values are blended from the
+     * middlegame and the endgame tables by the game phase. Drawn material is
+     * scored as draw, and endgames against a lone king are evaluated by a
+     * specialized evaluation.
+     * \param position The position to evaluate.
+     * \param color The player whose perspective is used for evaluation.
+     * \return The position's score.
+     */
+    auto static_evaluation(const chesscore::Position &position, chesscore::Color color) const -> Score;
+
+    /**
+     * \brief Evaluate a position from its incrementally updated terms.
+     *
+     * Gives the same score as the evaluation of the full position, but in
+     * constant time.
+     * \param position The position, maintaining its evaluation terms with piece_square_values().
+     * \param pawns The evaluation of the pawn structure of the position, see pawn_entry().
+     * \param material The evaluation data of the material of the position, see material_entry().
+     * \param color The player whose perspective is used for evaluation.
+     * \return The position's score.
+     */
+    auto static_evaluation(const EnginePosition &position, const PawnEntry &pawns, const MaterialEntry &material, chesscore::Color color) const -> Score;
+
+    /**
+     * \brief Evaluate the pawn structure of a position.
+     *
+     * \param board The pieces of the position.
+     * \return The pawn structure terms and the king shelter, without key.
+     */
+    auto pawn_entry(const BoardBitboards &board) const -> PawnEntry;
+
+    /**
+     * \brief Evaluate the pawns of a position.
+     *
+     * Counts doubled, isolated, backward and passed pawns of both colors. The
+     * result only depends on the pawns, so it can be stored in the pawn hash
+     * table.
+     * \param board The pieces of the position.
+     * \param entry Receives the scores and the passed pawns.
+     */
+    auto evaluate_pawn_structure(const BoardBitboards &board, PawnEntry &entry) const -> void;
+
+    /**
+     * \brief Evaluate the pawns in front of the kings.
+     *
+     * The shelter is only computed again, if a king has moved since it was
+     * stored in the entry.
+     * \param board The pieces of the position, with the same pawns as the entry.
+     * \param entry Receives the king shelter.
+     */
+    auto evaluate_king_shelter(const BoardBitboards &board, PawnEntry &entry) const -> void;
+
+    /**
+     * \brief Bring a pawn hash entry up to date for a position.
+     *
+     * If the entry belongs to another pawn structure, it is reset and the
+     * pawn structure is evaluated. The king shelter is updated in any case.
+     * \param board The pieces of the position.
+     * \param key The pawn key of the position.
+     * \param entry The entry from the pawn hash table.
+     * \return If the entry already belonged to the pawn structure.
+     */
+    auto update_pawn_entry(const BoardBitboards &board, HashKey key, PawnEntry &entry) const -> bool;
+
+    /**
+     * \brief Evaluate the material configuration of a position.
+     *
+     * Computes the game phase, the bishop pair and imbalance terms, recognizes
+     * material that is insufficient for a checkmate or hard to win, and selects
+     * the specialized evaluation of endgames against a lone king. The result
+     * only depends on the number of pieces of each kind, so it can be stored
+     * in the material hash table.
+     * \param board The pieces of the position.
+     * \return The evaluation data, without key.
+     */
+    auto material_entry(const BoardBitboards &board) const -> MaterialEntry;
+
+    /**
+     * \brief The precomputed values for the evaluation terms.
+     *
+     * \return Material and piece-square values of the configuration.
+     */
+    auto piece_square_values() const -> const PieceSquareValues & { return m_piece_square_values; }
+
+    /**
+     * \brief Score of a position without legal moves.
+     *
+     * The score is given from the perspective of the player to move.
+     * \param in_check If the player to move is in check.
+     * \return The score for being checkmated or stalemated.
+     */
+    static auto terminal_score(bool in_check) -> Score { return in_check ? -Score::Mate : Score{0}; }
+
     /**
      * \brief Evaluation of a single move.
      *
@@ -69,6 +175,26 @@ public:
      */
     auto evaluate_pieces_on_squares(const chesscore::Position &position, chesscore::Color color) const -> Score;
 
+    /**
+     * \brief Accumulate the endgame scores for pieces on squares.
+     *
+     * Like evaluate_pieces_on_squares(), but with the endgame tables.
+     * \param position The position to evaluate.
+     * \param color The color for which to evaluate.
+     * \return The caculated score.
+     */
+    auto evaluate_pieces_on_endgame_squares(const chesscore::Position &position, chesscore::Color color) const -> Score;
+
+    /**
+     * \brief Calculate the game phase of a position.
+     *
+     * The game phase is the sum of the phase weights of all pieces on the
+     * board, limited to EvaluatorConfig::max_game_phase.
+     * \param position The position.
+     * \return The game phase, from 0 for pawn endgames to EvaluatorConfig::max_game_phase.
+     */
+    auto game_phase(const chesscore::Position &position) const -> int;
+
     /**
      * \brief Get the score for a capturing move.
      *
@@ -91,8 +217,60 @@ public:
     auto get_promotion_score(const chesscore::Move &move) const -> Score;
 
     auto get_piece_movement_score(const chesscore::Move &move) const -> Score;
+
+    /**
+     * \brief Get the score for ordering captures and promotions.
+     *
+     * Captures are ordered by "most valuable victim, least valuable attacker":
+     * Captures of more valuable pieces come first and, among those, captures
+     * with less valuable pieces. Promotions gain the value difference between
+     * the new piece and the pawn.
+     * \param move The move to evaluate.
+     * \return The ordering score.
+     */
+    auto get_mvv_lva_score(const chesscore::Move &move) const -> Score;
+
+    /**
+     * \brief Static exchange evaluation of a move.
+     *
+     * Calculates the material balance of the exchange sequence on the target
+     * square of the move, when both sides recapture with their least valuable
+     * piece and may stop capturing at any time. Pieces attacking through the
+     * capturing pieces (x-rays) join the exchange, pawns reaching the last
+     * rank promote to a queen. Pins and checks are ignored.
+     * \param position The position before the move.
+     * \param move The move.
+     * \return The material gained (positive) or lost (negative) by the move.
+     */
+    auto see(const chesscore::Position &position, const chesscore::Move &move) const -> Score { return see(BoardBitboards{position}, move); }
+
+    /**
+     * \brief Static exchange evaluation of a move.
+     *
+     * Avoids collecting the pieces of the position again, when evaluating
+     * several moves of the same position.
+     * \param board The pieces of the position before the move.
+     * \param move The move.
+     * \return The material gained (positive) or lost (negative) by the move.
+     */
+    auto see(const BoardBitboards &board, const chesscore::Move &move) const -> Score;
 private:
     EvaluatorConfig m_config{};
+    PieceSquareValues m_piece_square_values{m_config};
+
+    /**
+     * \brief Combine the terms of the static evaluation.
+     *
+     * \param board The pieces of the position.
+     * \param material_balance Material difference from the perspective of the player.
+     * \param positional Piece-square terms from the perspective of the player.
+     * \param pawns The evaluation of the pawn structure.
+     * \param material The evaluation data of the material.
+     * \param color The player whose perspective is used for evaluation.
+     * \return The position's score.
+     */
+    auto combine_terms(const BoardBitboards &board, Score material_balance, TaperedScore positional, const PawnEntry &pawns, const MaterialEntry &material, chesscore::Color color) const
+        -> Score;
 };
 
 } // namespace chessengine
@@ -0,0 +1,102 @@
+/* ************************************************************************** *
+ * Chess Engine Maat                                                          *
+ * Chess playing engine                                                       *
+ * ************************************************************************** */
+
+#ifndef CHESSENGINE_HISTORY_H
+#define CHESSENGINE_HISTORY_H
+
+#include "chessengine/transposition_table.h"
+#include "chessengine/types.h"
+
+#include <chesscore/move.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+
+namespace chessengine {
+
+/**
+ * \brief Butterfly history of quiet moves.
+ *
+ * Counts, how successful a quiet move (identified by side, origin and target
+ * square) has been in causing cutoffs. Moves causing a cutoff receive a bonus,
+ * quiet moves searched before them without success receive a malus. The
+ * updates use "gravity": the closer a value is to the limit, the smaller the
+ * effect of further updates. Thus, the values stay within
+ * [-max_value, max_value] and adapt quickly, when a move stops being good.
+ */
+class HistoryTable {
+public:
+    static constexpr int max_value{16384}; ///< Limit of the history values.
+
+    /**
+     * \brief The history value of a move.
+     *
+     * \param color The side making the move.
+     * \param move The move.
+     * \return The history value.
+     */
+    auto value(chesscore::Color color, const chesscore::Move &move) const -> int { return m_values[color_index(color)][move.from.index()][move.to.index()]; }
+
+    /**
+     * \brief Update the history of a move.
+     *
+     * \param color The side making the move.
+     * \param move The move.
+     * \param bonus The bonus (positive) or malus (negative).
+     */
+    auto update(chesscore::Color color, const chesscore::Move &move, int bonus) -> void {
+        auto &entry = m_values[color_index(color)][move.from.index()][move.to.index()];
+        bonus = std::clamp(bonus, -max_value, max_value);
+        entry = static_cast<std::int16_t>(entry + bonus - entry * std::abs(bonus) / max_value);
+    }
+
+    /**
+     * \brief Bonus for a cutoff at the given depth.
+     *
+     * Cutoffs at higher remaining depth save more work and are rewarded more.
+     * \param depth The remaining depth.
+     * \return The bonus.
+     */
+    static auto bonus(Depth depth) -> int { return std::min(16 * depth.value * depth.value, 1600); }
+
+    auto clear() -> void { m_values = {}; }
+private:
+    std::array<std::array<std::array<std::int16_t, chesscore::Square::count>, chesscore::Square::count>, 2> m_values{}; ///< Values by side, from and to square.
+};
+
+/**
+ * \brief Table of refutations of moves.
+ *
+ * Stores for each move (identified by the moving piece and its target square)
+ * the reply that last caused a cutoff.
+ */
+class CountermoveTable {
+public:
+    /**
+     * \brief The countermove to a move.
+     *
+     * \param move The previous move.
+     * \return The move that refuted it most recently.
+     */
+    auto get(const chesscore::Move &move) const -> PackedMove { return m_moves[piece_index(move.piece)][move.to.index()]; }
+
+    /**
+     * \brief Store a refutation.
+     *
+     * \param move The previous move.
+     * \param countermove The move that refuted it.
+     */
+    auto set(const chesscore::Move &move, const chesscore::Move &countermove) -> void { m_moves[piece_index(move.piece)][move.to.index()] = PackedMove{countermove}; }
+
+    auto clear() -> void { m_moves = {}; }
+private:
+    std::array<std::array<PackedMove, chesscore::Square::count>, piece_index_count> m_moves{}; ///< Countermoves by piece and target square.
+};
+
+} // namespace chessengine
+
+#endif
@@ -9,6 +9,8 @@
 #include <chrono>
 #include <fstream>
 #include <iomanip>
+#include <mutex>
+#include <optional>
 #include <sstream>
 #include <string>
 
@@ -19,8 +21,8 @@ public:
     Logger() = default;
     Logger(const Logger &) = delete;
     auto operator=(const Logger &) -> Logger & = delete;
-    Logger(Logger &&) noexcept = default;
-    auto operator=(Logger &&) noexcept -> Logger & = default;
+    Logger(Logger &&) = delete;
+    auto operator=(Logger &&) -> Logger & = delete;
     ~Logger() { disable(); }
 
     static auto instance() -> Logger & {
@@ -106,8 +108,10 @@ private:
     bool m_enabled{false};
     std::ofstream m_file;
     int m_indent{0};
+    std::mutex m_mutex; ///< Serializes writes from the search threads.
 
     auto log_internal(const std::string &tag, const std::string &message) -> void {
+        std::scoped_lock lock{m_mutex};
         if (!m_file.is_open())
             return;
 
@@ -119,24 +123,37 @@ private:
     }
 };
 
+/**
+ * \brief Collects a log message with stream operators.
+ *
+ * The stream is only created, if logging is enabled when the message is
+ * started. Otherwise, the values are discarded without formatting them, so
+ * that log messages in the search cost no allocations.
+ */
 class LogStream {
 public:
-    explicit LogStream(void (Logger::*log_func)(const std::string &)) : m_log_func(log_func) {}
+    explicit LogStream(void (Logger::*log_func)(const std::string &)) : m_log_func(log_func) {
+        if (Logger::instance().is_enabled()) {
+            m_stream.emplace();
+        }
+    }
 
     template<typename T>
     auto operator<<(const T &value) -> LogStream & {
-        m_stream << value;
+        if (m_stream.has_value()) {
+            m_stream.value() << value;
+        }
         return *this;
     }
 
     ~LogStream() {
-        if (Logger::instance().is_enabled()) {
-            (Logger::instance().*m_log_func)(m_stream.str());
+        if (m_stream.has_value() && Logger::instance().is_enabled()) {
+            (Logger::instance().*m_log_func)(m_stream->str());
         }
     }
 private:
     void (Logger::*m_log_func)(const std::string &);
-    std::ostringstream m_stream;
+    std::optional<std::ostringstream> m_stream; ///< The message, only if logging is enabled.
 };
 
 inline auto log_indent() -> void {
@@ -0,0 +1,161 @@
+/* ************************************************************************** *
+ * Chess Engine Maat                                                          *
+ * Chess playing engine                                                       *
+ * ************************************************************************** */
+
+#ifndef CHESSENGINE_MATE_SOLVER_H
+#define CHESSENGINE_MATE_SOLVER_H
+
+#include "chessengine/engine_position.h"
+#include "chessengine/transposition_table.h"
+#include "chessengine/types.h"
+#include "chessengine/zobrist.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace chessengine {
+
+/**
+ * \brief Searches for forced mates with depth-first proof-number search.
+ *
+ * The solver answers the question "can the side to move force a mate in at
+ * most N moves?" with the df-pn algorithm. In contrast to the alpha-beta
+ * search, it does not evaluate positions. Instead, it directs the search to
+ * the moves that are the easiest to prove (few replies of the defender) or
+ * disprove, which makes it much faster on deep, narrow mating combinations.
+ *
+ * The attacker tries checking moves first; for the last move of the mate, only
+ * checks are generated. The defender tries all legal moves.
+ *
+ * Proof and disproof numbers are stored in a hash table owned by the solver.
+ * The table is independent of the transposition table of the search.
+ */
+class MateSolver {
+public:
+    static constexpr std::size_t default_size_mb{16}; ///< Default size of the hash table in megabytes.
+
+    /**
+     * \brief Create a solver.
+     *
+     * \param stop_requested Flag, that cancels the search when set.
+     * \param size_mb Size of the hash table in megabytes.
+     */
+    explicit MateSolver(const std::atomic<bool> &stop_requested, std::size_t size_mb = default_size_mb);
+
+    /**
+     * \brief Search for a mate in at most the given number of moves.
+     *
+     * Mates of increasing length are tried, so the shortest mate is found.
+     * The time and node limits of the stop parameters are respected; the
+     * depth limit is ignored.
+     * The best move of the returned statistics carries the mate score and the
+     * mating line, if a mate was proven. Otherwise, its score is
+     * Score::NegInfinity.
+     * \param position The position to solve.
+     * \param moves Maximum number of moves of the mating side.
+     * \param stop_params Time and node limits.
+     * \param start Start time of the search.
+     * \return Result and statistics of the search.
+     */
+    auto solve(EnginePosition &position, int moves, const StopParameters &stop_params, std::chrono::steady_clock::time_point start) -> SearchStats;
+
+    /**
+     * \brief Remove all entries from the hash table.
+     */
+    auto clear() -> void;
+private:
+    /**
+     * \brief Proof numbers of a node from the perspective of the side to move.
+     *
+     * phi is the number of leaves that have to be solved to prove a win for
+     * the side to move, delta is the number to prove its loss. For the
+     * attacker, these are the proof and disproof numbers; for the defender,
+     * they are swapped.
+     */
+    struct ProofNumbers {
+        std::uint32_t phi{1};   ///< Cost of proving a win for the side to move.
+        std::uint32_t delta{1}; ///< Cost of proving a loss for the side to move.
+    };
+
+    /**
+     * \brief Entry of the hash table.
+     */
+    struct Entry {
+        HashKey key{0};         ///< Key of the node (position and remaining plies).
+        ProofNumbers numbers{}; ///< Proof numbers of the node.
+        PackedMove best_move{}; ///< Move to the most promising child; the winning move of a proven node.
+    };
+
+    /**
+     * \brief A move from the current node and the key of the node it leads to.
+     */
+    struct Child {
+        chesscore::Move move; ///< The move.
+        HashKey key;          ///< Key of the child node.
+    };
+
+    const std::atomic<bool> &m_stop_requested;       ///< External request to stop the search.
+    std::vector<Entry> m_table;                      ///< The hash table, size is a power of two.
+    EnginePosition *m_position{nullptr};             ///< The position being solved.
+    StopParameters m_stop_params{};                  ///< Limits of the current search.
+    std::chrono::steady_clock::time_point m_start{}; ///< Start of the current search.
+    std::int64_t m_nodes{0};                         ///< Number of nodes expanded.
+    bool m_stopped{false};                           ///< If the current search was cancelled.
+
+    /**
+     * \brief Prove or disprove the current node within the thresholds.
+     *
+     * The node is expanded repeatedly, until one of its proof numbers reaches
+     * the corresponding threshold.
+     * \param remaining_plies Number of plies left for the mate.
+     * \param thresholds Thresholds for phi and delta.
+     * \return The proof numbers of the node.
+     */
+    auto search_node(int remaining_plies, ProofNumbers thresholds) -> ProofNumbers;
+
+    /**
+     * \brief Generate the moves of the current node.
+     *
+     * Checks are ordered first, and for the last move of the attacker only
+     * checks are generated. Children that are solved immediately (mate,
+     * stalemate, no plies left) are stored in the hash table.
+     * \param remaining_plies Number of plies left for the mate.
+     * \return The moves and keys of the children.
+     */
+    auto generate_children(int remaining_plies) -> std::vector<Child>;
+
+    /**
+     * \brief Proof numbers of a node, that is decided without a search.
+     *
+     * \param remaining_plies Number of plies left for the mate.
+     * \return The proof numbers, if the current position is decided.
+     */
+    auto terminal_numbers(int remaining_plies) const -> std::optional<ProofNumbers>;
+
+    /**
+     * \brief Extract the mating line from the hash table.
+     *
+     * \param remaining_plies Number of plies of the proven mate.
+     * \return The moves of the mate, starting with the current position.
+     */
+    auto mating_line(int remaining_plies) -> chesscore::MoveList;
+
+    /**
+     * \brief Check, if the search has to stop.
+     *
+     * \return If the search was cancelled or a limit is reached.
+     */
+    auto should_stop() -> bool;
+
+    auto node_key(int remaining_plies) const -> HashKey;
+    auto probe(HashKey key) const -> const Entry *;
+    auto store(HashKey key, ProofNumbers numbers, PackedMove best_move = {}) -> void;
+};
+
+} // namespace chessengine
+
+#endif
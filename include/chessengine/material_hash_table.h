@@ -0,0 +1,90 @@
+/* ************************************************************************** *
+ * Chess Engine Maat                                                          *
+ * Chess playing engine                                                       *
+ * ************************************************************************** */
+
+#ifndef CHESSENGINE_MATERIAL_HASH_TABLE_H
+#define CHESSENGINE_MATERIAL_HASH_TABLE_H
+
+#include "chessengine/attacks.h"
+#include "chessengine/config.h"
+#include "chessengine/types.h"
+#include "chessengine/zobrist.h"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+
+namespace chessengine {
+
+/**
+ * \brief Specialized evaluation of an endgame.
+ *
+ * \param board The pieces of the position.
+ * \param strong_side The side the endgame is evaluated for.
+ * \return Score for the strong side, that replaces the positional terms of the evaluation.
+ */
+using EndgameEvaluation = auto (*)(const BoardBitboards &board, chesscore::Color strong_side) -> Score;
+
+/**
+ * \brief Evaluation data of a material configuration.
+ *
+ * Everything that only depends on the number of pieces of each kind, so that
+ * it can be looked up by the material key of a position.
+ */
+struct alignas(32) MaterialEntry {
+    static constexpr std::uint8_t full_scale{64};    ///< Scale factor that leaves a score unchanged.
+    static constexpr std::uint8_t drawish_scale{16}; ///< Scale factor for endgames, that are hard to win.
+
+    HashKey key{0};                                            ///< Material key of the position the entry belongs to.
+    EndgameEvaluation endgame{nullptr};                        ///< Specialized evaluation of the endgame, if there is one.
+    TaperedScore imbalance{};                                  ///< Bishop pair and material imbalance from white's perspective.
+    std::array<std::uint8_t, 2> scale{full_scale, full_scale}; ///< Factors (of full_scale) for scores in favour of white and black.
+    std::uint8_t phase{0};                                     ///< Game phase of the material.
+    bool draw{false};                                          ///< If the material is insufficient for a checkmate by either side.
+    chesscore::Color strong_side{chesscore::Color::White};     ///< The side the endgame evaluation is for.
+};
+
+static_assert(sizeof(MaterialEntry) == 32, "two material entries fill a cache line");
+
+/**
+ * \brief Hash table for the evaluation data of material configurations.
+ *
+ * There are only few different material configurations in a search, so the
+ * table can be small. It is indexed by the material key of the position and
+ * always overwrites the entry in its slot. Each search thread has its own
+ * table, so no synchronization is needed.
+ */
+class MaterialHashTable {
+public:
+    static constexpr std::size_t default_entry_count{8192}; ///< Default number of entries (256 KiB).
+
+    /**
+     * \brief Create an empty table.
+     *
+     * \param entry_count Number of entries, rounded down to a power of two.
+     */
+    explicit MaterialHashTable(std::size_t entry_count = default_entry_count);
+
+    /**
+     * \brief The slot for a material key.
+     *
+     * The entry belongs to the material configuration, if its key matches.
+     * Otherwise, it has to be overwritten.
+     * \param key The material key of the position.
+     * \return The entry in the slot for the key.
+     */
+    auto entry(HashKey key) -> MaterialEntry & { return m_entries[key & (m_entry_count - 1)]; }
+
+    /**
+     * \brief Remove all entries.
+     */
+    auto clear() -> void;
+private:
+    std::unique_ptr<MaterialEntry[]> m_entries; ///< The entries.
+    std::size_t m_entry_count{0};               ///< Number of entries, a power of two.
+};
+
+} // namespace chessengine
+
+#endif
@@ -0,0 +1,171 @@
+/* ************************************************************************** *
+ * Chess Engine Maat                                                          *
+ * Chess playing engine                                                       *
+ * ************************************************************************** */
+
+#ifndef CHESSENGINE_MOVE_GENERATOR_H
+#define CHESSENGINE_MOVE_GENERATOR_H
+
+#include "chessengine/attacks.h"
+#include "chessengine/engine_position.h"
+#include "chessengine/move_list.h"
+
+#include <chesscore/move.h>
+
+#include <cstdint>
+
+namespace chessengine {
+
+using GeneratedMoves = FixedList<chesscore::Move, max_moves>; ///< Moves produced by the move generator.
+
+/**
+ * \brief Generates the moves of a position from its bitboards.
+ *
+ * The generator produces pseudo-legal moves: moves that follow the movement
+ * rules of the pieces, but may leave the own king in check. Castling moves
+ * are only generated, if the king does not pass an attacked square. The
+ * legality of a move is checked separately with is_legal(), which is cheap,
+ * because the checking pieces and the pinned pieces are computed once, when
+ * the generator is created. This way, the search only pays for the legality
+ * check of the moves it actually plays.
+ *
+ * The moves are generated in groups: captures (including en-passant captures
+ * and all promotions), quiet moves (including castling) and check evasions.
+ * Captures and quiets together are all pseudo-legal moves of a position,
+ * the evasions are a smaller set of moves, that contains all legal moves,
+ * when the side to move is in check.
+ *
+ * The moves are complete chesscore::Move values, that can be made on the
+ * position.
+ */
+class MoveGenerator {
+public:
+    /**
+     * \brief Create a generator for a position.
+     *
+     * \param position The position.
+     */
+    explicit MoveGenerator(const EnginePosition &position);
+
+    /**
+     * \brief Create a generator for a position given by its parts.
+     *
+     * \param board The pieces.
+     * \param side_to_move The side to move.
+     * \param castling_rights Castling rights as bit set of EnginePosition::white_kingside etc.
+     * \param en_passant_file File of the en-passant target square, -1 for none.
+     */
+    MoveGenerator(const BoardBitboards &board, chesscore::Color side_to_move, std::uint8_t castling_rights, int en_passant_file);
+
+    /**
+     * \brief Check, if the side to move is in check.
+     *
+     * \return If the king of the side to move is attacked.
+     */
+    auto in_check() const -> bool { return m_checkers != 0; }
+
+    /**
+     * \brief The pieces of the position.
+     *
+     * \return The bitboards.
+     */
+    auto board() const -> const BoardBitboards & { return m_board; }
+
+    /**
+     * \brief The side to move.
+     *
+     * \return Color of the side to move.
+     */
+    auto side_to_move() const -> chesscore::Color { return m_us; }
+
+    /**
+     * \brief Generate captures and promotions.
+     *
+     * \param moves The moves are appended to this list.
+     */
+    auto generate_captures(GeneratedMoves &moves) const -> void;
+
+    /**
+     * \brief Generate moves, that neither capture nor promote.
+     *
+     * Castling is only generated, when the side to move is not in check.
+     * \param moves The moves are appended to this list.
+     */
+    auto generate_quiets(GeneratedMoves &moves) const -> void;
+
+    /**
+     * \brief Generate the moves, that may resolve a check.
+     *
+     * These are the king moves, and in case of a single check, the captures of
+     * the checking piece and the moves to the squares between the checking
+     * piece and the king. The side to move has to be in check.
+     * \param moves The moves are appended to this list.
+     */
+    auto generate_evasions(GeneratedMoves &moves) const -> void;
+
+    /**
+     * \brief Generate all pseudo-legal moves.
+     *
+     * These are the evasions, when in check, and all captures and quiet moves
+     * otherwise.
+     * \param moves The moves are appended to this list.
+     */
+    auto generate_moves(GeneratedMoves &moves) const -> void;
+
+    /**
+     * \brief Check, if a pseudo-legal move is legal.
+     *
+     * \param move A move generated by this generator.
+     * \return If the move does not leave the own king in check.
+     */
+    auto is_legal(const chesscore::Move &move) const -> bool;
+
+    /**
+     * \brief Generate all legal moves.
+     *
+     * \param moves The moves are appended to this list.
+     */
+    auto generate_legal_moves(GeneratedMoves &moves) const -> void;
+
+    /**
+     * \brief Check, if the side to move has a legal move.
+     *
+     * Stops at the first legal move found, which is cheaper than generating
+     * all legal moves.
+     * \return If there is at least one legal move.
+     */
+    auto has_legal_moves() const -> bool;
+private:
+    BoardBitboards m_board;                   ///< The pieces.
+    chesscore::Color m_us;                    ///< The side to move.
+    chesscore::Color m_them;                  ///< The opponent.
+    std::uint8_t m_castling;                  ///< Castling rights as bit set.
+    int m_en_passant;                         ///< File of the en-passant target square, -1 for none.
+    std::size_t m_king{0};                    ///< Square of the king of the side to move.
+    Bitboard m_checkers{0};                   ///< Pieces giving check to the king of the side to move.
+    Bitboard m_pinned{0};                     ///< Pieces of the side to move, that are pinned to their king.
+    Bitboard m_evasion_targets{~Bitboard{0}}; ///< Squares a piece other than the king has to move to, to resolve a check.
+
+    /**
+     * \brief Generate pawn moves.
+     *
+     * With promotions set, these are the captures to the capture targets
+     * (including en passant), and the promotions by a push to the push
+     * targets. Otherwise, these are the single and double pushes to the push
+     * targets, that do not promote.
+     * \param moves The moves are appended to this list.
+     * \param captures Squares of the pieces that may be captured.
+     * \param pushes Empty squares the pawns may move to.
+     * \param promotions Which group of moves to generate.
+     */
+    auto generate_pawn_moves(GeneratedMoves &moves, Bitboard captures, Bitboard pushes, bool promotions) const -> void;
+    auto generate_piece_moves(GeneratedMoves &moves, Bitboard targets) const -> void;
+    auto generate_king_moves(GeneratedMoves &moves, Bitboard targets) const -> void;
+    auto generate_castling(GeneratedMoves &moves) const -> void;
+    auto add_move(GeneratedMoves &moves, std::size_t from, std::size_t to, chesscore::PieceType type) const -> void;
+    auto add_promotions(GeneratedMoves &moves, std::size_t from, std::size_t to) const -> void;
+};
+
+} // namespace chessengine
+
+#endif
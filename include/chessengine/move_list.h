@@ -0,0 +1,52 @@
+/* ************************************************************************** *
+ * Chess Engine Maat                                                          *
+ * Chess playing engine                                                       *
+ * ************************************************************************** */
+
+#ifndef CHESSENGINE_MOVE_LIST_H
+#define CHESSENGINE_MOVE_LIST_H
+
+#include <array>
+#include <cstddef>
+
+namespace chessengine {
+
+constexpr std::size_t max_moves{256}; ///< Upper bound for the number of legal moves in a position (the known maximum is 218).
+
+/**
+ * \brief A list with a fixed capacity, that stores its elements inline.
+ *
+ * In contrast to std::vector, the list never allocates memory. Clearing it
+ * keeps the storage, so a list that is reused for every node of the search
+ * costs nothing but the copies of its elements.
+ * The capacity must not be exceeded.
+ */
+template<typename T, std::size_t Capacity>
+class FixedList {
+public:
+    using value_type = T;
+    using iterator = typename std::array<T, Capacity>::iterator;
+    using const_iterator = typename std::array<T, Capacity>::const_iterator;
+
+    auto push_back(const T &value) -> void { m_elements[m_size++] = value; }
+    auto clear() -> void { m_size = 0; }
+
+    auto size() const -> std::size_t { return m_size; }
+    auto empty() const -> bool { return m_size == 0; }
+    static constexpr auto capacity() -> std::size_t { return Capacity; }
+
+    auto operator[](std::size_t index) -> T & { return m_elements[index]; }
+    auto operator[](std::size_t index) const -> const T & { return m_elements[index]; }
+
+    auto begin() -> iterator { return m_elements.begin(); }
+    auto end() -> iterator { return m_elements.begin() + static_cast<std::ptrdiff_t>(m_size); }
+    auto begin() const -> const_iterator { return m_elements.begin(); }
+    auto end() const -> const_iterator { return m_elements.begin() + static_cast<std::ptrdiff_t>(m_size); }
+private:
+    std::array<T, Capacity> m_elements{}; ///< Storage for the elements.
+    std::size_t m_size{0};                ///< Number of elements in the list.
+};
+
+} // namespace chessengine
+
+#endif
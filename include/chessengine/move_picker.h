@@ -0,0 +1,137 @@
+/* ************************************************************************** *
+ * Chess Engine Maat                                                          *
+ * Chess playing engine                                                       *
+ * ************************************************************************** */
+
+#ifndef CHESSENGINE_MOVE_PICKER_H
+#define CHESSENGINE_MOVE_PICKER_H
+
+#include "chessengine/evaluation.h"
+#include "chessengine/history.h"
+#include "chessengine/move_generator.h"
+#include "chessengine/move_list.h"
+#include "chessengine/transposition_table.h"
+
+#include <chesscore/move.h>
+
+#include <cstdint>
+#include <optional>
+#include <span>
+
+namespace chessengine {
+
+/**
+ * \brief Information from the search for ordering quiet moves.
+ */
+struct MoveOrderingHints {
+    std::span<const PackedMove> killers{}; ///< Killer moves of the current ply.
+    PackedMove countermove{};              ///< Refutation of the previous move.
+    const HistoryTable *history{nullptr};  ///< History of quiet moves.
+};
+
+/**
+ * \brief Hands out the moves of a position in the order they should be searched.
+ *
+ * The pseudo-legal moves are generated and scored once, when the picker is
+ * created. They are then selected lazily: each call to next() looks for the
+ * best of the remaining moves and checks its legality. If the search of an
+ * early move produces a cutoff, the remaining moves never need to be sorted
+ * or checked.
+ * The scored moves are kept in a buffer provided by the caller, which the
+ * search reuses for all nodes at the same ply, so no memory is allocated.
+ *
+ * The moves are returned in stages:
+ *  1. the hash move (from the transposition table or the principal variation),
+ *  2. winning and equal captures (by static exchange evaluation), by MVV-LVA,
+ *  3. promotions,
+ *  4. killer moves and the countermove,
+ *  5. quiet moves, by their history and move score,
+ *  6. losing captures, by MVV-LVA.
+ */
+class MovePicker {
+public:
+    /**
+     * \brief The stages of the move picker.
+     */
+    enum class Stage : std::uint8_t {
+        HashMove,      ///< The hash move.
+        GoodCaptures,  ///< Captures that do not lose material in the static exchange evaluation.
+        Promotions,    ///< Pawn promotions without capture.
+        Killers,       ///< Quiet moves that caused cutoffs in sibling positions, and the countermove.
+        Quiets,        ///< All other quiet moves.
+        LosingCaptures ///< Captures that lose material in the static exchange evaluation.
+    };
+
+    /**
+     * \brief A move together with its ordering information.
+     */
+    struct ScoredMove {
+        chesscore::Move move{}; ///< The move.
+        Stage stage{};          ///< The stage in which the move is searched.
+        std::int32_t score{0};  ///< Order of the move within its stage (highest first).
+
+        auto before(const ScoredMove &other) const -> bool { return stage < other.stage || (stage == other.stage && score > other.score); }
+    };
+
+    using MoveBuffer = FixedList<ScoredMove, max_moves>; ///< Storage for the moves of a picker.
+
+    /**
+     * \brief Create a picker for all legal moves.
+     *
+     * \param buffer Storage for the scored moves. Its previous content is discarded.
+     * \param generator Move generator for the position. It has to outlive the picker.
+     * \param evaluator Evaluator used for scoring the moves.
+     * \param hash_move The move to search first.
+     * \param hints Killer moves, countermove and history for ordering quiet moves.
+     * \param use_ordering If the moves should be ordered at all. Otherwise, they are returned as generated.
+     */
+    MovePicker(
+        MoveBuffer &buffer, const MoveGenerator &generator, const Evaluator &evaluator, PackedMove hash_move, const MoveOrderingHints &hints = {}, bool use_ordering = true
+    );
+
+    /**
+     * \brief Create a picker for captures and promotions only.
+     *
+     * Used by the quiescence search. Captures are ordered by MVV-LVA, with
+     * the losing captures (by static exchange evaluation) last.
+     * \param buffer Storage for the scored moves. Its previous content is discarded.
+     * \param generator Move generator for the position. It has to outlive the picker.
+     * \param evaluator Evaluator used for scoring the moves.
+     * \return The move picker.
+     */
+    static auto captures(MoveBuffer &buffer, const MoveGenerator &generator, const Evaluator &evaluator) -> MovePicker;
+
+    /**
+     * \brief The next move to search.
+     *
+     * Moves that are not legal are skipped.
+     * \return The move or std::nullopt, if all legal moves have been returned.
+     */
+    auto next() -> std::optional<chesscore::Move>;
+
+    /**
+     * \brief Stage of the move returned by the last call to next().
+     *
+     * \return The stage.
+     */
+    auto stage() const -> Stage { return m_stage; }
+
+    /**
+     * \brief Number of pseudo-legal moves.
+     *
+     * \return The number of moves, including those that turn out to be illegal.
+     */
+    auto size() const -> std::size_t { return m_moves.size(); }
+private:
+    MovePicker(MoveBuffer &buffer, const MoveGenerator &generator) : m_moves{buffer}, m_generator{generator} { m_moves.clear(); }
+
+    MoveBuffer &m_moves;              ///< The scored moves.
+    const MoveGenerator &m_generator; ///< Generator of the moves, checks their legality.
+    std::size_t m_current{0};         ///< Number of moves returned so far.
+    bool m_use_ordering{true};        ///< If the moves have to be selected by stage and score.
+    Stage m_stage{Stage::HashMove};   ///< Stage of the last returned move.
+};
+
+} // namespace chessengine
+
+#endif
@@ -0,0 +1,84 @@
+/* ************************************************************************** *
+ * Chess Engine Maat                                                          *
+ * Chess playing engine                                                       *
+ * ************************************************************************** */
+
+#ifndef CHESSENGINE_PAWN_HASH_TABLE_H
+#define CHESSENGINE_PAWN_HASH_TABLE_H
+
+#include "chessengine/attacks.h"
+#include "chessengine/types.h"
+#include "chessengine/zobrist.h"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+
+namespace chessengine {
+
+/**
+ * \brief Evaluation of the pawn structure of a position.
+ *
+ * The scores are given from white's perspective. The pawn structure terms
+ * only depend on the pawns, the king shelter additionally on the squares of
+ * the kings. It is recomputed, when the kings have moved.
+ */
+struct alignas(32) PawnEntry {
+    static constexpr std::uint8_t no_square{0xFF}; ///< King square, if the shelter has not been computed.
+
+    HashKey key{0};                                                 ///< Pawn key of the position the entry belongs to.
+    std::array<Bitboard, 2> passed_pawns{0, 0};                     ///< Passed pawns of white and black.
+    Score middlegame{0};                                            ///< Middlegame score of the pawn structure.
+    Score endgame{0};                                               ///< Endgame score of the pawn structure.
+    Score king_shelter{0};                                          ///< Middlegame score of the pawns in front of the kings.
+    std::array<std::uint8_t, 2> king_squares{no_square, no_square}; ///< Squares of the white and black king the shelter was computed for.
+};
+
+static_assert(sizeof(PawnEntry) == 32, "two pawn entries fill a cache line");
+
+/**
+ * \brief Hash table for the evaluation of pawn structures.
+ *
+ * The pawn structure rarely changes during the search, so most positions
+ * share their pawns with a position evaluated before. The table is indexed
+ * by the pawn key of the position and always overwrites the entry in its
+ * slot. Each search thread has its own table, so no synchronization is
+ * needed.
+ *
+ * An unused entry has the key 0, which is the pawn key of positions without
+ * pawns. This is consistent, as the pawn structure terms of such a position
+ * are all zero.
+ */
+class PawnHashTable {
+public:
+    static constexpr std::size_t default_entry_count{16384}; ///< Default number of entries (512 KiB).
+
+    /**
+     * \brief Create an empty table.
+     *
+     * \param entry_count Number of entries, rounded down to a power of two.
+     */
+    explicit PawnHashTable(std::size_t entry_count = default_entry_count);
+
+    /**
+     * \brief The slot for a pawn key.
+     *
+     * The entry belongs to the pawn structure, if its key matches. Otherwise,
+     * it has to be overwritten.
+     * \param key The pawn key of the position.
+     * \return The entry in the slot for the key.
+     */
+    auto entry(HashKey key) -> PawnEntry & { return m_entries[key & (m_entry_count - 1)]; }
+
+    /**
+     * \brief Remove all entries.
+     */
+    auto clear() -> void;
+private:
+    std::unique_ptr<PawnEntry[]> m_entries; ///< The entries.
+    std::size_t m_entry_count{0};           ///< Number of entries, a power of two.
+};
+
+} // namespace chessengine
+
+#endif
@@ -0,0 +1,124 @@
+/* ************************************************************************** *
+ * Chess Engine Maat                                                          *
+ * Chess playing engine                                                       *
+ * ************************************************************************** */
+
+#ifndef CHESSENGINE_PERFT_H
+#define CHESSENGINE_PERFT_H
+
+#include "chessengine/engine_position.h"
+#include "chessengine/zobrist.h"
+
+#include <chesscore/move.h>
+#include <chesscore/position.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace chessengine {
+
+/**
+ * \brief Settings for counting the leaves of the move tree.
+ */
+struct PerftConfig {
+    std::size_t threads{1};      ///< Number of threads the root moves are distributed to.
+    std::size_t hash_size_mb{0}; ///< Size of the perft cache in megabytes, 0 disables the cache.
+};
+
+/**
+ * \brief Result of a perft run.
+ */
+struct PerftResult {
+    int depth{0};                                                       ///< Depth of the move tree.
+    std::uint64_t nodes{0};                                             ///< Number of leaves of the move tree.
+    std::vector<std::pair<chesscore::Move, std::uint64_t>> root_moves{}; ///< Number of leaves below each legal root move.
+    std::chrono::milliseconds elapsed_time{0};                          ///< Time needed for the counting.
+
+    /**
+     * \brief Compute the leaves counted per second.
+     *
+     * \return Leaves per second, if the time was measurable.
+     */
+    auto calculate_nps() const -> std::optional<std::uint64_t> {
+        const auto ms_count = elapsed_time.count();
+        if (ms_count != 0) {
+            return nodes * 1000 / static_cast<std::uint64_t>(ms_count);
+        }
+        return {};
+    }
+};
+
+/**
+ * \brief Counts the leaves of the move tree of a position (perft).
+ *
+ * Perft validates the move generator against known node counts and measures
+ * its speed. The moves are generated with the MoveGenerator and made on an
+ * EnginePosition, just as in the search.
+ *
+ * At the last ply, the legal moves are only counted and not made (bulk
+ * counting). The legal root moves are distributed to several threads, each
+ * counting the subtrees on its own copy of the position.
+ *
+ * Optionally, the counts of subtrees are stored in a hash table shared by the
+ * threads, so that transpositions are counted only once. Like the
+ * transposition table, the cache stores the key XORed with the data, so that
+ * torn writes of concurrent threads are detected on probing.
+ */
+class Perft {
+public:
+    /**
+     * \brief Create a perft counter.
+     *
+     * \param config Number of threads and size of the cache.
+     */
+    explicit Perft(const PerftConfig &config = {});
+
+    /**
+     * \brief Count the leaves of the move tree.
+     *
+     * \param position The root position.
+     * \param depth Depth of the move tree in plies.
+     * \return The total count and the counts for the root moves.
+     */
+    auto run(const chesscore::Position &position, int depth) -> PerftResult;
+private:
+    struct Entry {
+        std::atomic<std::uint64_t> check{0}; ///< Key XOR nodes.
+        std::atomic<std::uint64_t> nodes{0}; ///< Number of leaves below the node.
+    };
+
+    PerftConfig m_config;             ///< Number of threads and size of the cache.
+    std::unique_ptr<Entry[]> m_cache; ///< The perft cache, empty if disabled.
+    std::size_t m_cache_size{0};      ///< Number of entries in the cache, a power of two.
+
+    /**
+     * \brief Count the leaves below a position.
+     *
+     * \param position The position, unchanged on return.
+     * \param depth Remaining depth, at least 1.
+     * \return Number of leaves.
+     */
+    auto count(EnginePosition &position, int depth) -> std::uint64_t;
+
+    auto probe(HashKey key) const -> std::optional<std::uint64_t>;
+    auto store(HashKey key, std::uint64_t nodes) -> void;
+};
+
+/**
+ * \brief Format the result of a perft run.
+ *
+ * \param result The result.
+ * \param divide If the counts for the root moves are listed.
+ * \return Report with the counts, the time and the nodes per second.
+ */
+auto to_string(const PerftResult &result, bool divide) -> std::string;
+
+} // namespace chessengine
+
+#endif
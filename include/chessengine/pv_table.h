@@ -0,0 +1,72 @@
+/* ************************************************************************** *
+ * Chess Engine Maat                                                          *
+ * Chess playing engine                                                       *
+ * ************************************************************************** */
+
+#ifndef CHESSENGINE_PV_TABLE_H
+#define CHESSENGINE_PV_TABLE_H
+
+#include "chessengine/types.h"
+
+#include <chesscore/move.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+
+namespace chessengine {
+
+/**
+ * \brief Triangular table collecting the principal variation.
+ *
+ * Row `ply` holds the best line found so far, starting at the node at the
+ * given ply. When a move raises alpha, it is stored together with the line of
+ * its child node, which is found in row `ply + 1`. After the search, row 0
+ * contains the principal variation from the root.
+ */
+class PVTable {
+public:
+    static constexpr std::size_t max_ply{max_search_ply}; ///< Maximum distance from the root that can be stored.
+
+    /**
+     * \brief Start a new node.
+     *
+     * Clears the line stored for the given ply.
+     * \param ply Distance of the node from the root.
+     */
+    auto clear(std::size_t ply) -> void { m_length[ply] = ply; }
+
+    /**
+     * \brief Store a new best move.
+     *
+     * The line of the node is set to the move followed by the line of the
+     * child node.
+     * \param ply Distance of the node from the root.
+     * \param move The new best move.
+     */
+    auto update(std::size_t ply, const chesscore::Move &move) -> void {
+        m_moves[ply][ply] = move;
+        const auto child_length = ply + 1 < max_ply ? m_length[ply + 1] : ply + 1;
+        for (auto index = ply + 1; index < child_length; ++index) {
+            m_moves[ply][index] = m_moves[ply + 1][index];
+        }
+        m_length[ply] = std::max(child_length, ply + 1);
+    }
+
+    /**
+     * \brief The line stored for a ply.
+     *
+     * \param ply Distance of the node from the root.
+     * \return The moves of the line.
+     */
+    auto line(std::size_t ply = 0) const -> chesscore::MoveList {
+        return chesscore::MoveList{m_moves[ply].begin() + static_cast<std::ptrdiff_t>(ply), m_moves[ply].begin() + static_cast<std::ptrdiff_t>(m_length[ply])};
+    }
+private:
+    std::array<std::array<chesscore::Move, max_ply>, max_ply> m_moves{}; ///< Lines for each ply.
+    std::array<std::size_t, max_ply> m_length{};                          ///< End of the line for each ply.
+};
+
+} // namespace chessengine
+
+#endif
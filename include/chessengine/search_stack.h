@@ -0,0 +1,84 @@
+/* ************************************************************************** *
+ * Chess Engine Maat                                                          *
+ * Chess playing engine                                                       *
+ * ************************************************************************** */
+
+#ifndef CHESSENGINE_SEARCH_STACK_H
+#define CHESSENGINE_SEARCH_STACK_H
+
+#include "chessengine/move_picker.h"
+#include "chessengine/transposition_table.h"
+#include "chessengine/types.h"
+
+#include <chesscore/move.h>
+
+#include <algorithm>
+#include <array>
+#include <optional>
+
+namespace chessengine {
+
+/**
+ * \brief Information about a node on the current search path.
+ */
+struct SearchStackEntry {
+    std::array<PackedMove, 2> killers{};         ///< Quiet moves that caused cutoffs at this ply.
+    std::optional<chesscore::Move> current_move; ///< The move currently searched from this node.
+    bool null_move{false};                       ///< If the current move is a null move.
+    std::size_t extensions{0};                   ///< Number of check extensions on the path to this node.
+    std::optional<Score> static_eval;            ///< Static evaluation of the node, if it may be pruned.
+    MovePicker::MoveBuffer moves{};              ///< Storage for the moves of the node.
+
+    /**
+     * \brief Remember a quiet move that caused a cutoff.
+     *
+     * The move becomes the first killer, the previous first killer becomes
+     * the second one.
+     * \param move The move.
+     */
+    auto add_killer(const chesscore::Move &move) -> void {
+        const PackedMove killer{move};
+        if (killers[0] != killer) {
+            killers[1] = killers[0];
+            killers[0] = killer;
+        }
+    }
+};
+
+/**
+ * \brief Per-ply information for the nodes of the search path.
+ *
+ * Entry `ply` belongs to the node at that distance from the root.
+ * The stack holds the move buffers of all plies, so it is large and should
+ * be allocated once per search thread.
+ */
+class SearchStack {
+public:
+    auto operator[](std::size_t ply) -> SearchStackEntry & { return m_entries[ply]; }
+    auto operator[](std::size_t ply) const -> const SearchStackEntry & { return m_entries[ply]; }
+
+    /**
+     * \brief The move that led to the node at the given ply.
+     *
+     * \param ply Distance from the root.
+     * \return The previous move, if any.
+     */
+    auto previous_move(std::size_t ply) const -> const std::optional<chesscore::Move> & { return ply > 0 ? m_entries[ply - 1].current_move : m_no_move; }
+
+    /**
+     * \brief Checks, if the node at the given ply was reached by a null move.
+     *
+     * \param ply Distance from the root.
+     * \return If the previous move was a null move.
+     */
+    auto after_null_move(std::size_t ply) const -> bool { return ply > 0 && m_entries[ply - 1].null_move; }
+
+    auto clear() -> void { std::ranges::fill(m_entries, SearchStackEntry{}); }
+private:
+    std::array<SearchStackEntry, max_search_ply> m_entries{}; ///< The entries by ply.
+    std::optional<chesscore::Move> m_no_move{};               ///< Returned as previous move of the root.
+};
+
+} // namespace chessengine
+
+#endif
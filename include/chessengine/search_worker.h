@@ -0,0 +1,399 @@
+/* ************************************************************************** *
+ * Chess Engine Maat                                                          *
+ * Chess playing engine                                                       *
+ * ************************************************************************** */
+
+#ifndef CHESSENGINE_SEARCH_WORKER_H
+#define CHESSENGINE_SEARCH_WORKER_H
+
+#include "chessengine/config.h"
+#include "chessengine/engine_position.h"
+#include "chessengine/eval_cache.h"
+#include "chessengine/evaluation.h"
+#include "chessengine/history.h"
+#include "chessengine/material_hash_table.h"
+#include "chessengine/move_picker.h"
+#include "chessengine/pawn_hash_table.h"
+#include "chessengine/pv_table.h"
+#include "chessengine/search_stack.h"
+#include "chessengine/transposition_table.h"
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <span>
+#include <string>
+
+namespace chessengine {
+
+/**
+ * \brief State shared by all threads of a search.
+ */
+struct SearchSharedState {
+    std::atomic<bool> stop{false};             ///< Set, when all threads should stop searching (also by the deadline timer).
+    std::atomic<std::int64_t> helper_nodes{0}; ///< Nodes searched by the helper threads (updated periodically).
+};
+
+/**
+ * \brief A thread of the search.
+ *
+ * Each worker searches its own copy of the position with iterative deepening.
+ * In a multi-threaded search (Lazy SMP), the workers only communicate via the
+ * shared transposition table. The main worker (id 0) checks the stopping
+ * criteria and reports the progress of the search. Helper workers search
+ * until the main worker signals the end of the search.
+ */
+class SearchWorker {
+public:
+    using ProgressCallback = std::function<void(const SearchStats &)>;
+
+    SearchWorker(int id, const Config &config, const Evaluator &evaluator, TranspositionTable &transposition_table, SearchSharedState &shared_state,
+                 const std::atomic<bool> &stop_requested);
+
+    /**
+     * \brief Prepare the worker for a new search.
+     *
+     * \param position The position to search.
+     * \param stop_params The stopping criteria.
+     * \param search_start Start time of the search.
+     */
+    auto prepare(const EnginePosition &position, const StopParameters &stop_params, std::chrono::steady_clock::time_point search_start) -> void;
+
+    /**
+     * \brief Search the position with iterative deepening.
+     *
+     * Blocks until the search is finished or stopped.
+     */
+    auto search() -> void;
+
+    /**
+     * \brief Register a callback for the progress of the search.
+     *
+     * Called after each completed iteration, and when the search of an
+     * iteration fails outside of its aspiration window (reporting a bound for
+     * the score). Only called by the main worker.
+     * \param callback The callback.
+     */
+    auto on_progress(ProgressCallback callback) -> void { m_progress_callback = std::move(callback); }
+
+    auto id() const -> int { return m_id; }
+    auto is_main() const -> bool { return m_id == 0; }
+
+    /**
+     * \brief The best move of the deepest completed iteration.
+     *
+     * \return The best move.
+     */
+    auto best_move() const -> const EvaluatedMove & { return m_best_move; }
+
+    /**
+     * \brief Depth of the deepest completed iteration.
+     *
+     * \return The completed depth.
+     */
+    auto completed_depth() const -> Depth { return m_search_stats.depth; }
+
+    /**
+     * \brief Statistics of this worker.
+     *
+     * Not thread-safe, only use after the search or from the worker's own
+     * thread.
+     * \return The statistics.
+     */
+    auto search_stats() const -> const SearchStats & { return m_search_stats; }
+private:
+    int m_id;                                             ///< Number of the worker, 0 for the main worker.
+    const Config &m_config;                               ///< The engine configuration.
+    const Evaluator &m_evaluator;                         ///< Evaluation of positions.
+    TranspositionTable &m_transposition_table;            ///< Table shared by all workers.
+    SearchSharedState &m_shared_state;                    ///< State shared by all workers.
+    const std::atomic<bool> &m_stop_requested;            ///< Stop requested by the user.
+    EnginePosition m_position;                            ///< This worker's copy of the position.
+    SearchStats m_search_stats{};                         ///< Statistics of this worker.
+    EvaluatedMove m_best_move{};                          ///< The best move found so far.
+    StopParameters m_stopping_params{};                   ///< Parameters for the stopping criteria.
+    std::chrono::steady_clock::time_point m_search_start; ///< Start of the search.
+    ProgressCallback m_progress_callback{};               ///< Callback for the search progress.
+    int m_check_counter{0};                               ///< Calls to check_stop() since the node count was last published.
+    std::int64_t m_published_nodes{0};                    ///< Nodes already added to the shared node count.
+    PVTable m_pv_table{};                                 ///< Principal variation of the current iteration.
+    bool m_follow_pv{false};                              ///< If the current node is on the principal variation of the previous iteration.
+    bool m_aborted{false};                                ///< If the running search has been stopped.
+    SearchStack m_stack{};                                ///< Killer moves, current moves and move buffers along the search path.
+    HistoryTable m_history{};                             ///< History of quiet moves causing cutoffs.
+    CountermoveTable m_countermoves{};                    ///< Refutations of the opponent's moves.
+    PawnHashTable m_pawn_table{};                         ///< Evaluations of pawn structures, kept between searches.
+    MaterialHashTable m_material_table{};                 ///< Evaluation data of material configurations, kept between searches.
+    EvalCache m_eval_cache;                               ///< Static evaluations of positions, kept between searches.
+    std::size_t m_null_move_min_ply{0};                   ///< Null moves are only tried from this ply on (while verifying a null move cutoff).
+
+    static constexpr int publish_interval{2048};
+    static constexpr std::size_t max_penalized_quiets{64};
+
+    /**
+     * \brief Checks, if a running search should be stopped.
+     *
+     * There might be different reasons why a search should stop as soon as
+     * possible. These include a request by the user, the node limit or the
+     * deadline (signalled by the engine's timer thread through the shared
+     * stop flag). Only the main worker checks the request and the node limit,
+     * helper workers only react to the shared stop flag.
+     * Once stopped, the search functions return immediately. Their results
+     * are meaningless and must not be used or stored.
+     * \return If the search should be stopped.
+     */
+    auto check_stop() -> bool;
+
+    auto stop(const std::string &reason) -> void;
+    auto publish_nodes() -> void;
+    auto search_time() const -> std::chrono::milliseconds;
+
+    /**
+     * \brief Search the root position with aspiration windows.
+     *
+     * The search starts with a narrow window around the score of the previous
+     * iteration. If the score falls outside, the window is widened on that
+     * side and the search is repeated. Mate scores are searched with the full
+     * window.
+     * \param depth The search depth.
+     * \return The best move.
+     */
+    auto aspiration_search(Depth depth) -> EvaluatedMove;
+
+    /**
+     * \brief Report a score outside of the aspiration window.
+     *
+     * \param depth The search depth.
+     * \param result Result of the failed search.
+     * \param bound Kind of bound the score is.
+     */
+    auto report_bound(Depth depth, const EvaluatedMove &result, ScoreBound bound) -> void;
+
+    auto search_position(Depth depth, Bounds bounds) -> EvaluatedMove;
+
+    /**
+     * \brief Search a position below the root.
+     *
+     * Uses principal variation search: the first move is searched with the
+     * full window, all other moves with a zero window. Only if a move turns
+     * out to be better than the first one, it is searched again with the full
+     * window. Repetitions and positions drawn by the fifty-move rule are
+     * scored as draws without a search.
+     * \param depth The remaining search depth.
+     * \param bounds The search window.
+     * \param ply Distance from the root.
+     * \return The score of the position.
+     */
+    auto search_position(Depth depth, Bounds bounds, std::size_t ply) -> Score;
+
+    /**
+     * \brief Search a move with principal variation search.
+     *
+     * Has to be called with the move made on the board.
+     * \param depth The remaining depth of the parent position (including the extension of the move).
+     * \param bounds The search window of the parent position.
+     * \param ply Distance of the parent position from the root.
+     * \param first_move If this is the first move searched in the parent position.
+     * \param reduction Late move reduction. A reduced search that fails high is repeated with full depth.
+     * \return The score of the move from the perspective of the parent position.
+     */
+    auto search_move(Depth depth, Bounds bounds, std::size_t ply, bool first_move, Depth reduction) -> Score;
+
+    /**
+     * \brief Depth extension for a move giving check.
+     *
+     * Moves giving check are searched one ply deeper, so that forced
+     * sequences of checks (e.g. mating attacks) are seen earlier. The number
+     * of extensions on a path is limited by MinimaxConfig::max_check_extensions.
+     * Has to be called with the move made on the board.
+     * \param ply Distance of the parent position from the root.
+     * \return The extension.
+     */
+    auto check_extension(std::size_t ply) -> Depth;
+
+    /**
+     * \brief Depth reduction for a move late in the move order.
+     *
+     * With good move ordering, moves searched late rarely produce a cutoff,
+     * so they are searched with less depth. Captures, promotions, moves giving
+     * check, the hash move, killer moves and the countermove are never reduced.
+     * Has to be called with the move made on the board.
+     * \param depth The remaining depth of the parent position.
+     * \param move_number Number of the move in the move order (starting at 1).
+     * \param move The move.
+     * \param stage Move picker stage of the move.
+     * \return The reduction.
+     */
+    auto late_move_reduction(Depth depth, std::size_t move_number, const chesscore::Move &move, MovePicker::Stage stage) const -> Depth;
+
+    /**
+     * \brief Determine the move to search first in a position.
+     *
+     * While the search follows the principal variation of the previous
+     * iteration, this is the next move of that variation. Otherwise, it is
+     * the move from the transposition table.
+     * \param ply Distance from the root.
+     * \param hash_move The move from the transposition table.
+     * \return The move to search first.
+     */
+    auto first_move_to_search(std::size_t ply, PackedMove hash_move) const -> PackedMove;
+
+    /**
+     * \brief Static evaluation of the current node for the pruning decisions.
+     *
+     * Nodes on the principal variation (followed from the previous iteration
+     * or searched with an open window), nodes in check and nodes with a mate
+     * score as bound are never pruned. No evaluation is done for them.
+     * \param bounds The search window.
+     * \return The static evaluation, or std::nullopt, if the node must not be pruned.
+     */
+    auto pruning_evaluation(const Bounds &bounds) -> std::optional<Score>;
+
+    /**
+     * \brief Static evaluation of the current position for the side to move.
+     *
+     * Taken from the evaluation cache, if the position was evaluated before.
+     * Otherwise, uses the evaluation terms, that the position updates with
+     * every move, and the pawn and material hash tables. Debug builds check
+     * them against the evaluation of the full position.
+     * \return The score of the position.
+     */
+    auto static_evaluation() -> Score;
+
+    /**
+     * \brief Evaluation of the pawn structure of the current position.
+     *
+     * Taken from the pawn hash table, if the pawn structure was evaluated
+     * before. Otherwise, it is evaluated and stored in the table.
+     * \return The pawn hash entry of the position.
+     */
+    auto pawn_entry() -> const PawnEntry &;
+
+    /**
+     * \brief Evaluation data of the material of the current position.
+     *
+     * Taken from the material hash table, if the material configuration was
+     * seen before. Otherwise, it is computed and stored in the table.
+     * \return The material hash entry of the position.
+     */
+    auto material_entry() -> const MaterialEntry &;
+
+    /**
+     * \brief Evaluate a position at the end of the search without quiescence search.
+     *
+     * The legal moves are only generated, if the side to move is in check, to
+     * tell a check from a checkmate.
+     * \return The score of the position.
+     */
+    auto leaf_evaluation() -> Score;
+
+    /**
+     * \brief Try to resolve a node near the horizon without searching its moves.
+     *
+     * Reverse futility pruning cuts off nodes whose static evaluation exceeds
+     * beta by a depth dependent margin. Razoring resolves nodes whose static
+     * evaluation is far below alpha by a quiescence search, if that confirms
+     * the fail low.
+     * \param depth The remaining search depth.
+     * \param bounds The search window.
+     * \param ply Distance from the root.
+     * \param static_eval Static evaluation of the node.
+     * \return The score of the node, or std::nullopt, if the node has to be searched.
+     */
+    auto prune_node(Depth depth, const Bounds &bounds, std::size_t ply, Score static_eval) -> std::optional<Score>;
+
+    /**
+     * \brief Checks, if a move near the horizon can be skipped.
+     *
+     * Futility pruning skips quiet moves, when the static evaluation plus a
+     * depth dependent margin does not reach alpha. Late move pruning skips
+     * quiet moves after a depth dependent number of moves has been searched.
+     * Captures are skipped, if they lose more than a depth dependent margin
+     * in the static exchange evaluation. The hash move, killer moves and the
+     * countermove are never skipped.
+     * \param depth The remaining search depth.
+     * \param bounds The search window.
+     * \param static_eval Static evaluation of the node.
+     * \param move_number Number of the move in the move order (starting at 1).
+     * \param move The move.
+     * \param stage Move picker stage of the move.
+     * \return If the move can be skipped.
+     */
+    auto prune_move(Depth depth, const Bounds &bounds, Score static_eval, std::size_t move_number, const chesscore::Move &move, MovePicker::Stage stage) const -> bool;
+
+    /**
+     * \brief Checks, if null move pruning may be tried in the current node.
+     *
+     * Passing the move must not be tried, when the side to move is in check
+     * (the null move would be illegal), directly after another null move, or
+     * in positions with a high risk of zugzwang (only king and pawns left).
+     * It is also not tried on the principal variation and when the static
+     * evaluation is below beta.
+     * \param depth The remaining search depth.
+     * \param bounds The search window.
+     * \param ply Distance from the root.
+     * \param static_eval Static evaluation of the node, std::nullopt if it must not be pruned.
+     * \return If a null move should be tried.
+     */
+    auto null_move_allowed(Depth depth, const Bounds &bounds, std::size_t ply, std::optional<Score> static_eval) const -> bool;
+
+    /**
+     * \brief Search the current node after a null move.
+     *
+     * If the position is still good enough for a cutoff after passing the move
+     * to the opponent, a real move would most probably be even better. The
+     * null move is searched with a reduced depth and a zero window at beta.
+     * At high depths, a cutoff is verified by a reduced search of the node
+     * without null moves in the first plies.
+     * \param depth The remaining search depth.
+     * \param bounds The search window.
+     * \param ply Distance from the root.
+     * \return The score for the cutoff, or std::nullopt, if the node has to be searched.
+     */
+    auto null_move_search(Depth depth, const Bounds &bounds, std::size_t ply) -> std::optional<Score>;
+
+    /**
+     * \brief Search captures and promotions until the position is quiet.
+     *
+     * The side to move may "stand pat" and accept the static evaluation
+     * instead of capturing. This avoids misjudging positions in the middle of
+     * an exchange at the end of the nominal search depth. A side in check
+     * cannot stand pat; all its evasions are searched, and it is checkmated,
+     * if there are none. At the maximum search ply, the static evaluation is
+     * returned.
+     * \param bounds The search window.
+     * \param ply Distance from the root.
+     * \return The score of the position.
+     */
+    auto quiescence_search(Bounds bounds, std::size_t ply) -> Score;
+
+    /**
+     * \brief Create the move picker for the current position.
+     *
+     * The moves are stored in the move buffer of the search stack entry for
+     * the ply, so the picker is valid until the next picker for that ply is
+     * created.
+     * \param generator Move generator for the current position.
+     * \param first_move The move to search first.
+     * \param ply Distance from the root.
+     * \return The move picker.
+     */
+    auto move_picker(const MoveGenerator &generator, PackedMove first_move, std::size_t ply) -> MovePicker;
+
+    /**
+     * \brief Update the move ordering tables after a quiet move caused a cutoff.
+     *
+     * The move becomes a killer move at the given ply and the countermove of
+     * the previous move. Its history is increased, while the history of the
+     * quiet moves searched before is decreased.
+     * \param depth The remaining depth of the node.
+     * \param ply Distance of the node from the root.
+     * \param move The move that caused the cutoff.
+     * \param quiets_searched Quiet moves searched before without a cutoff.
+     */
+    auto update_quiet_move_history(Depth depth, std::size_t ply, const chesscore::Move &move, std::span<const chesscore::Move> quiets_searched) -> void;
+};
+
+} // namespace chessengine
+
+#endif
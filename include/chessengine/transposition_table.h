@@ -0,0 +1,162 @@
+/* ************************************************************************** *
+ * Chess Engine Maat                                                          *
+ * Chess playing engine                                                       *
+ * ************************************************************************** */
+
+#ifndef CHESSENGINE_TRANSPOSITION_TABLE_H
+#define CHESSENGINE_TRANSPOSITION_TABLE_H
+
+#include "chessengine/types.h"
+#include "chessengine/zobrist.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+namespace chessengine {
+
+/**
+ * \brief A move packed into 16 bits.
+ *
+ * Stores origin, target and promotion piece type of a move. This is enough to
+ * identify a move among the legal moves of a position.
+ */
+class PackedMove {
+public:
+    PackedMove() = default;
+    explicit PackedMove(const chesscore::Move &move);
+    explicit PackedMove(std::uint16_t bits) : m_bits{bits} {}
+
+    auto bits() const -> std::uint16_t { return m_bits; }
+
+    /**
+     * \brief Check, if a move is stored.
+     *
+     * \return If no move is stored.
+     */
+    auto empty() const -> bool { return m_bits == 0; }
+
+    /**
+     * \brief Check, if this is the packed version of a move.
+     *
+     * \param move The move.
+     * \return If the given move matches the stored move.
+     */
+    auto matches(const chesscore::Move &move) const -> bool { return !empty() && PackedMove{move}.m_bits == m_bits; }
+
+    auto operator==(const PackedMove &other) const -> bool = default;
+private:
+    std::uint16_t m_bits{0};
+};
+
+/**
+ * \brief Search result for a position stored in the transposition table.
+ *
+ * Scores are stored relative to the position they belong to: a mate score
+ * counts the plies to the mate from that position, as it is returned by the
+ * search. The scores can therefore be used in every transposition, regardless
+ * of the distance to the search root.
+ */
+struct TranspositionEntry {
+    PackedMove move;                    ///< Best move found in the position.
+    Score score{0};                     ///< Score of the position.
+    Depth depth{0};                     ///< Remaining search depth the score was computed for.
+    ScoreBound bound{ScoreBound::None}; ///< Kind of the score.
+};
+
+/**
+ * \brief Hash table for search results, indexed by Zobrist keys.
+ *
+ * The table consists of buckets, each filling one cache line. A bucket holds
+ * several entries. When storing a new result, the entry for the same position
+ * is replaced. Otherwise, the entry that is least valuable (shallow depth and
+ * stored in a previous search) is overwritten.
+ *
+ * The table can be shared between threads without locking. Each entry stores
+ * the key XORed with the data, so that torn writes of concurrent threads are
+ * detected as a key mismatch on probing.
+ */
+class TranspositionTable {
+public:
+    static constexpr std::size_t default_size_mb{16}; ///< Default size of the table in megabytes.
+
+    explicit TranspositionTable(std::size_t size_mb = default_size_mb) { resize(size_mb); }
+
+    /**
+     * \brief Change the size of the table.
+     *
+     * The number of buckets is the largest power of two, that fits into the
+     * given size. The table is cleared.
+     * \param size_mb Size of the table in megabytes.
+     */
+    auto resize(std::size_t size_mb) -> void;
+
+    /**
+     * \brief Size of the table in megabytes.
+     *
+     * \return The size given with the last resize.
+     */
+    auto size_mb() const -> std::size_t { return m_size_mb; }
+
+    /**
+     * \brief Remove all entries.
+     */
+    auto clear() -> void;
+
+    /**
+     * \brief Signal the start of a new search.
+     *
+     * Entries from previous searches are preferably replaced.
+     */
+    auto new_search() -> void { m_generation = static_cast<std::uint8_t>(m_generation + 1); }
+
+    /**
+     * \brief Look up a position.
+     *
+     * \param key Zobrist key of the position.
+     * \return The stored entry, if the position is in the table.
+     */
+    auto probe(HashKey key) const -> std::optional<TranspositionEntry>;
+
+    /**
+     * \brief Store a search result.
+     *
+     * If no move is given, but the table already contains a move for this
+     * position, the stored move is kept.
+     * \param key Zobrist key of the position.
+     * \param entry The search result.
+     */
+    auto store(HashKey key, const TranspositionEntry &entry) -> void;
+
+    /**
+     * \brief Estimate how full the table is.
+     *
+     * \return Number of used entries from the current search per thousand entries.
+     */
+    auto hashfull() const -> int;
+private:
+    struct Entry {
+        std::atomic<std::uint64_t> check{0}; ///< Key XOR data.
+        std::atomic<std::uint64_t> data{0};  ///< Packed TranspositionEntry and generation.
+    };
+
+    static constexpr std::size_t cache_line_size{64};
+    static constexpr std::size_t entries_per_bucket{cache_line_size / sizeof(Entry)};
+
+    struct alignas(cache_line_size) Bucket {
+        std::array<Entry, entries_per_bucket> entries;
+    };
+
+    std::unique_ptr<Bucket[]> m_buckets;
+    std::size_t m_bucket_count{0};
+    std::size_t m_size_mb{0};
+    std::uint8_t m_generation{0};
+
+    auto bucket(HashKey key) const -> Bucket & { return m_buckets[key & (m_bucket_count - 1)]; }
+};
+
+} // namespace chessengine
+
+#endif
@@ -75,6 +75,19 @@ struct [[nodiscard]] Score : public StrongType<std::int16_t, struct ScoreTag> {
     static const Score Mate;        ///< The score for a mate in the current position.
 };
 
+/**
+ * \brief Kind of information a search score carries.
+ *
+ * A score returned from an alpha-beta search is only exact, if it lies within
+ * the search window. Otherwise, it is a bound for the true score.
+ */
+enum class ScoreBound : std::uint8_t {
+    None,  ///< No information available.
+    Exact, ///< The score is exact.
+    Lower, ///< The true score is at least this score (fail high).
+    Upper, ///< The true score is at most this score (fail low).
+};
+
 /**
  * \brief Bounds for evaluation during alpha-beta-search.
  */
@@ -82,7 +95,16 @@ struct Bounds {
     Score alpha{Score::NegInfinity}; ///< α bound
     Score beta{Score::Infinity};     ///< β bound
 
-    auto swap() -> Bounds { return {-beta, -alpha}; }
+    constexpr auto swap() const -> Bounds { return {-beta, -alpha}; }
+
+    /**
+     * \brief A window of width one at the lower bound.
+     *
+     * Searching with a zero window only tells, if a score is above or below
+     * alpha, but produces more cutoffs than a full window search.
+     * \return The zero window.
+     */
+    auto zero_window() const -> Bounds { return {alpha, Score{static_cast<Score::value_type>(alpha.value + 1)}}; }
 };
 
 /**
@@ -232,28 +254,160 @@ constexpr auto ply_to_mate(Score score) -> Depth {
     return Depth{(Score::Mate - score).value};
 }
 
+/**
+ * \brief Checks, if a search result is a proven mate.
+ *
+ * A search to the given depth finds all mates within that many plies. So, if
+ * the mate is not farther away than the search depth, no shorter mate exists
+ * and deeper searches cannot change the result.
+ * \param score The score of the search.
+ * \param depth The depth of the search.
+ * \return If the score is a mate within the search depth.
+ */
+constexpr auto is_proven_mate(Score score, Depth depth) -> bool {
+    return is_decisive_score(score) && ply_to_mate(score) <= depth;
+}
+
+/**
+ * \brief Adjust a score taken from a child position.
+ *
+ * Mate scores count the plies to the mate. Looking at it from the parent
+ * position, the mate is one ply further away.
+ * \param score The (negated) score of the child position.
+ * \return The score from the perspective of the parent position.
+ */
+constexpr auto adjust_mate_distance(Score score) -> Score {
+    if (is_winning_score(score)) {
+        return score - Depth::Step;
+    }
+    if (is_losing_score(score)) {
+        return score + Depth::Step;
+    }
+    return score;
+}
+
+/**
+ * \brief The search window of a child position.
+ *
+ * The inverse of adjust_mate_distance(): the window is seen from the
+ * opponent's perspective, and mate score bounds are one ply closer to the
+ * mate. Thus, a child score lies within the window, if and only if the
+ * adjusted score lies within the parent's window. Infinite bounds stay
+ * infinite.
+ *
+ * A mate at the edge of the mate range is adjusted to the best score that is
+ * not a mate. Therefore, a lower bound just below the mate range is also
+ * moved, and so is an upper bound just above the range of the opponent's
+ * mates.
+ * \param bounds The search window of the parent position.
+ * \return The search window of the child position.
+ */
+constexpr auto child_bounds(const Bounds &bounds) -> Bounds {
+    const auto alpha_to_child = [](Score alpha) -> Score {
+        if (is_winning_score(alpha + Depth::Step) && alpha < Score::Infinity) {
+            return alpha + Depth::Step;
+        }
+        if (is_losing_score(alpha) && alpha > Score::NegInfinity) {
+            return alpha - Depth::Step;
+        }
+        return alpha;
+    };
+    const auto beta_to_child = [](Score beta) -> Score {
+        if (is_winning_score(beta) && beta < Score::Infinity) {
+            return beta + Depth::Step;
+        }
+        if (is_losing_score(beta - Depth::Step) && beta > Score::NegInfinity) {
+            return beta - Depth::Step;
+        }
+        return beta;
+    };
+    return Bounds{alpha_to_child(bounds.alpha), beta_to_child(bounds.beta)}.swap();
+}
+
+/**
+ * \brief Index of a color for table lookups.
+ *
+ * \param color The color.
+ * \return 0 for white, 1 for black.
+ */
+constexpr auto color_index(chesscore::Color color) -> std::size_t {
+    return color == chesscore::Color::White ? 0 : 1;
+}
+
+constexpr std::size_t max_search_ply{128}; ///< Maximum distance from the root of the search tree.
+
+constexpr std::size_t piece_index_count{12}; ///< Number of different pieces (type and color).
+
+/**
+ * \brief Index of a piece for table lookups.
+ *
+ * The white pieces come first (in the order of chesscore::PieceType), followed
+ * by the black pieces.
+ * \param piece The piece.
+ * \return Index of the piece in the range [0, piece_index_count).
+ */
+constexpr auto piece_index(chesscore::Piece piece) -> std::size_t {
+    return color_index(piece.color()) * 6 + get_index(piece.type());
+}
+
 /**
  * \brief A move combined with a score.
  */
 struct EvaluatedMove {
     chesscore::Move move;            ///< The move.
     Score score{Score::NegInfinity}; ///< Score for the move.
+    chesscore::MoveList pv{};        ///< Principal variation, starting with the move.
 };
 
 /**
  * \brief Statistics of the last search.
  */
 struct SearchStats {
-    std::int64_t nodes{0};                  ///< Number of noes evaluated during search.
-    std::int64_t cutoffs{0};                ///< Number of branches cut off during search.
-    EvaluatedMove best_move;                ///< Best move so far.
-    Depth depth;                            ///< Depth reached so far.
-    std::chrono::milliseconds elapsed_time; ///< Time spent so far.
+    std::int64_t nodes{0};                     ///< Number of noes evaluated during search.
+    std::int64_t qnodes{0};                    ///< Number of nodes evaluated during quiescence search.
+    std::int64_t cutoffs{0};                   ///< Number of branches cut off during search.
+    std::int64_t tt_hits{0};                   ///< Number of nodes resolved by the transposition table.
+    std::int64_t first_move_cutoffs{0};        ///< Number of cutoffs caused by the first move searched in a node.
+    std::int64_t reduced_moves{0};             ///< Number of moves searched with a late move reduction.
+    std::int64_t re_searches{0};               ///< Number of reduced moves searched again with full depth.
+    std::int64_t pawn_hash_probes{0};          ///< Number of pawn structure evaluations looked up in the pawn hash table.
+    std::int64_t pawn_hash_hits{0};            ///< Number of pawn structure evaluations found in the pawn hash table.
+    std::int64_t eval_cache_probes{0};         ///< Number of static evaluations looked up in the evaluation cache.
+    std::int64_t eval_cache_hits{0};           ///< Number of static evaluations found in the evaluation cache.
+    EvaluatedMove best_move;                   ///< Best move so far.
+    ScoreBound score_bound{ScoreBound::Exact}; ///< If the score of the best move is exact, or only a bound after a failed aspiration window.
+    Depth depth;                               ///< Depth reached so far.
+    std::chrono::milliseconds elapsed_time;    ///< Time spent so far.
+
+    auto total_nodes() const -> std::int64_t { return nodes + qnodes; }
+
+    /**
+     * \brief Fraction of cutoffs caused by the first move of a node.
+     *
+     * A measure for the quality of the move ordering. With perfect ordering,
+     * every cutoff is caused by the first move.
+     * \return The first move cutoff rate in [0, 1].
+     */
+    auto first_move_cutoff_rate() const -> double { return cutoffs > 0 ? static_cast<double>(first_move_cutoffs) / static_cast<double>(cutoffs) : 0.0; }
+
+    /**
+     * \brief Fraction of pawn structure evaluations found in the pawn hash table.
+     *
+     * \return The pawn hash hit rate in [0, 1].
+     */
+    auto pawn_hash_hit_rate() const -> double { return pawn_hash_probes > 0 ? static_cast<double>(pawn_hash_hits) / static_cast<double>(pawn_hash_probes) : 0.0; }
+
+    /**
+     * \brief Fraction of static evaluations found in the evaluation cache.
+     *
+     * \return The evaluation cache hit rate in [0, 1].
+     */
+    auto eval_cache_hit_rate() const -> double { return eval_cache_probes > 0 ? static_cast<double>(eval_cache_hits) / static_cast<double>(eval_cache_probes) : 0.0; }
 
     auto calculate_nps() const -> std::optional<std::uint64_t> {
         const auto ms_count = elapsed_time.count();
         if (ms_count != 0) {
-            return nodes * 1000 / ms_count;
+            return total_nodes() * 1000 / ms_count;
         } else {
             return {};
         }
@@ -276,6 +430,8 @@ struct StopParameters {
     Depth max_search_depth = Depth::Zero;
     /// Maximum number of nodes to evaluate. 0 means "no restriction"
     std::int64_t max_search_nodes{0};
+    /// Search for a mate in at most this many moves with the mate solver. 0 means "regular search"
+    int mate_in_moves{0};
 };
 
 auto to_string(const StopParameters &params) -> std::string;
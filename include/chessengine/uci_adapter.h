@@ -6,18 +6,24 @@
 #ifndef CHESS_ENGINE_MAAT_UCIADAPTER_H
 #define CHESS_ENGINE_MAAT_UCIADAPTER_H
 
+#include "chessengine/bench.h"
 #include "chessengine/chess_engine.h"
 #include "chessengine/logger.h"
+#include "chessengine/perft.h"
 
 #include <chesscore/fen.h>
 #include <chessuci/engine_handler.h>
 
 #include <algorithm>
+#include <charconv>
 #include <condition_variable>
+#include <format>
 #include <iosfwd>
 #include <mutex>
+#include <optional>
 #include <sstream>
 #include <string>
+#include <string_view>
 
 namespace chessengine {
 
@@ -45,10 +51,29 @@ static inline auto position_to_string(const chesscore::Position &position) -> st
     return result.str();
 }
 
+/**
+ * \brief Parse a number given by the GUI or on the command line.
+ *
+ * \tparam T Type of the number.
+ * \param text The text.
+ * \return The number, or std::nullopt, if the text is not a number of the type.
+ */
+template<typename T>
+auto parse_number(std::string_view text) -> std::optional<T> {
+    T value{};
+    const auto *const end = text.data() + text.size();
+    const auto [last, error] = std::from_chars(text.data(), end, value);
+    if (error != std::errc{} || last != end) {
+        return std::nullopt;
+    }
+    return value;
+}
+
 } // namespace detail
 
 using UCIMoveList = std::vector<chessuci::UCIMove>;
 
+auto start_position(const chessuci::position_command &command) -> chesscore::Position;
 auto construct_position(const chessuci::position_command &command) -> std::pair<chesscore::Position, UCIMoveList>;
 
 template<typename EngineT = ChessEngine>
@@ -71,6 +96,7 @@ public:
     auto uci_callback() -> void {
         log_uci_out("sending UCI identification");
         m_handler.send_id({.name = ChessEngine::identifier, .author = ChessEngine::author});
+        send_options();
         log_uci_out("sending uciok");
         m_handler.send_uciok();
     }
@@ -85,9 +111,35 @@ public:
         m_handler.send_readyok();
     }
 
-    auto set_option_callback([[maybe_unused]] const chessuci::setoption_command &command) -> void {
+    auto set_option_callback(const chessuci::setoption_command &command) -> void {
+        if (command.name == "Hash" && command.value.has_value()) {
+            if (const auto value = spin_value(command, min_hash_size_mb, max_hash_size_mb); value.has_value()) {
+                auto config = m_engine.config();
+                config.search_config.hash_size_mb = value.value();
+                log_info_stream() << "setting hash size to " << config.search_config.hash_size_mb << " MB";
+                m_engine.set_config(config);
+            }
+            return;
+        }
+        if (command.name == "EvalCache" && command.value.has_value()) {
+            if (const auto value = spin_value(command, min_eval_cache_size_mb, max_eval_cache_size_mb); value.has_value()) {
+                auto config = m_engine.config();
+                config.search_config.eval_cache_size_mb = value.value();
+                log_info_stream() << "setting evaluation cache size to " << config.search_config.eval_cache_size_mb << " MB";
+                m_engine.set_config(config);
+            }
+            return;
+        }
+        if (command.name == "Threads" && command.value.has_value()) {
+            if (const auto value = spin_value(command, min_threads, max_threads); value.has_value()) {
+                auto config = m_engine.config();
+                config.search_config.threads = value.value();
+                log_info_stream() << "setting number of search threads to " << config.search_config.threads;
+                m_engine.set_config(config);
+            }
+            return;
+        }
         log_info_stream() << "request to set option '" << command.name << "' ignored";
-        // currently no options
     }
 
     auto uci_new_game_callback() -> void {
@@ -125,6 +177,7 @@ public:
         stop_params.max_search_depth = Depth{static_cast<Depth::value_type>(command.depth.value_or(0))};
         stop_params.max_search_nodes = command.nodes.value_or(0);
         stop_params.max_search_time = compute_target_movetime(command);
+        stop_params.mate_in_moves = command.mate.value_or(0);
         log_info_stream() << "starting search with stopping criteria: " << to_string(stop_params);
         m_engine.start_search(stop_params);
     }
@@ -155,13 +208,70 @@ public:
 
     auto display_board() -> void { m_handler.send_raw(detail::position_to_string(m_engine.position())); }
 
+    /**
+     * \brief Count the leaves of the move tree of the current position.
+     *
+     * Handles the custom commands "perft <depth>" and "divide <depth>". The
+     * counting uses the configured number of threads and a perft cache of the
+     * configured hash size.
+     * \param tokens The command and its arguments.
+     * \param divide If the counts for the root moves are reported.
+     */
+    auto perft_command(const chessuci::TokenList &tokens, bool divide) -> void {
+        const auto depth = tokens.size() < 2 ? std::nullopt : detail::parse_number<int>(tokens[1]);
+        if (!depth.has_value() || depth.value() < 0) {
+            log_error_stream() << "invalid or missing depth for command '" << tokens[0] << "', usage: " << tokens[0] << " <depth>";
+            return;
+        }
+        const auto &search_config = m_engine.config().search_config;
+        Perft perft{PerftConfig{.threads = search_config.threads, .hash_size_mb = search_config.hash_size_mb}};
+        const auto result = perft.run(m_engine.position(), depth.value());
+        log_info_stream() << "perft " << result.depth << ": " << result.nodes << " nodes in " << result.elapsed_time.count() << "ms";
+        m_handler.send_raw(to_string(result, divide));
+    }
+
+    /**
+     * \brief Run the benchmark.
+     *
+     * Handles the custom command "bench [depth]". The benchmark uses its own
+     * engines, so the state of the engine is not changed.
+     * \param tokens The command and its arguments.
+     */
+    auto bench_command(const chessuci::TokenList &tokens) -> void {
+        BenchConfig config{};
+        if (tokens.size() > 1) {
+            const auto depth = detail::parse_number<int>(tokens[1]);
+            if (!depth.has_value() || depth.value() < 1) {
+                log_error_stream() << "invalid depth '" << tokens[1] << "' for command 'bench', usage: bench [depth]";
+                return;
+            }
+            config.depth = depth.value();
+        }
+        log_info_stream() << "running benchmark at depth " << config.depth;
+        m_handler.send_raw(to_string(run_bench(config)));
+    }
+
     auto unknown_command_handler(const chessuci::TokenList &tokens) -> void { log_error_stream() << "unknown command '" << tokens[0] << '\''; }
 
     auto setup_position(const chessuci::position_command &command) -> void {
         m_position_setup = command.fen;
-        const auto constructed = construct_position(command);
-        m_engine.set_position(constructed.first);
-        m_move_list = constructed.second;
+        const auto start = start_position(command);
+        auto position = start;
+        chesscore::MoveList moves;
+        for (const auto &move : command.moves) {
+            const auto matched_move = chessuci::convert_legal_move(move, position);
+            if (!matched_move.has_value()) {
+                throw chessuci::UCIError{"Invalid move " + to_string(move)};
+            }
+            position.make_move(matched_move.value());
+            moves.push_back(matched_move.value());
+        }
+        // Play the moves on the engine, so that it knows the positions of the game for repetition detection.
+        m_engine.set_position(start);
+        for (const auto &move : moves) {
+            m_engine.play_move(move);
+        }
+        m_move_list = command.moves;
     }
 
     auto engine_finished_search(const EvaluatedMove &move) -> void {
@@ -173,11 +283,16 @@ public:
 
     auto engine_search_progress(SearchStats search_stats) -> void {
         chessuci::search_info info{};
-        info.pv.push_back(chessuci::UCIMove{search_stats.best_move.move});
+        for (const auto &move : search_stats.best_move.pv) {
+            info.pv.push_back(chessuci::UCIMove{move});
+        }
+        if (info.pv.empty()) {
+            info.pv.push_back(chessuci::UCIMove{search_stats.best_move.move});
+        }
         info.currmove = chessuci::UCIMove{search_stats.best_move.move};
         info.depth = search_stats.depth.value;
         info.seldepth = search_stats.depth.value;
-        info.nodes = search_stats.nodes;
+        info.nodes = search_stats.total_nodes();
         info.time = search_stats.elapsed_time.count();
         info.nps = search_stats.calculate_nps();
         auto score = search_stats.best_move.score;
@@ -187,6 +302,8 @@ public:
         } else {
             info.score->cp = score.value;
         }
+        info.score->lowerbound = search_stats.score_bound == ScoreBound::Lower;
+        info.score->upperbound = search_stats.score_bound == ScoreBound::Upper;
         log_info_stream() << "search progress " << to_string(info.currmove.value()) << ", depth " << info.depth.value() << ", nodes " << info.nodes.value() << "; time "
                           << info.time.value() << "ms";
         m_handler.send_info(info);
@@ -201,10 +318,35 @@ private:
 
     static constexpr int sudden_death_moves{40};
     static constexpr std::int64_t search_stop_buffer{50};
+    static constexpr std::size_t min_hash_size_mb{1};
+    static constexpr std::size_t max_hash_size_mb{4096};
+    static constexpr std::size_t min_eval_cache_size_mb{0};
+    static constexpr std::size_t max_eval_cache_size_mb{256};
+    static constexpr std::size_t min_threads{1};
+    static constexpr std::size_t max_threads{256};
+
+    /**
+     * \brief The value of a spin option.
+     *
+     * \param command The setoption command, with a value.
+     * \param min Smallest value of the option.
+     * \param max Largest value of the option.
+     * \return The value clamped to the range of the option, or std::nullopt, if it is not a number.
+     */
+    static auto spin_value(const chessuci::setoption_command &command, std::size_t min, std::size_t max) -> std::optional<std::size_t> {
+        const auto value = detail::parse_number<std::size_t>(command.value.value());
+        if (!value.has_value()) {
+            log_error_stream() << "invalid value '" << command.value.value() << "' for option '" << command.name << "' ignored";
+            return std::nullopt;
+        }
+        return std::clamp(value.value(), min, max);
+    }
 
     auto register_callbacks() -> void {
         m_handler.on_uci([this]() -> void { uci_callback(); });
         m_handler.on_isready([this]() -> void { is_ready_callback(); });
+        m_handler.on_setoption([this](const chessuci::setoption_command &command) -> void { set_option_callback(command); });
+        m_handler.on_ucinewgame([this]() -> void { uci_new_game_callback(); });
         m_handler.on_position([this](const chessuci::position_command &command) -> void { position_callback(command); });
         m_handler.on_go([this](const chessuci::go_command &command) -> void { go_callback(command); });
         m_handler.on_stop([this]() -> void { stop_callback(); });
@@ -212,12 +354,27 @@ private:
         m_handler.on_quit([this]() -> void { quit_callback(); });
 
         m_handler.register_command("d", [this](const chessuci::TokenList &) -> void { display_board(); });
+        m_handler.register_command("perft", [this](const chessuci::TokenList &tokens) -> void { perft_command(tokens, false); });
+        m_handler.register_command("divide", [this](const chessuci::TokenList &tokens) -> void { perft_command(tokens, true); });
+        m_handler.register_command("bench", [this](const chessuci::TokenList &tokens) -> void { bench_command(tokens); });
         m_handler.on_unknown_command([this](const chessuci::TokenList &tokens) -> void { unknown_command_handler(tokens); });
 
         m_engine.on_search_ended([this](const EvaluatedMove &move) -> void { engine_finished_search(move); });
         m_engine.on_search_progress([this](SearchStats search_stats) -> void { engine_search_progress(search_stats); });
     }
 
+    /**
+     * \brief Announce the options supported by the engine.
+     */
+    auto send_options() -> void {
+        log_uci_out("sending options");
+        m_handler.send_raw(std::format("option name Hash type spin default {} min {} max {}\n", TranspositionTable::default_size_mb, min_hash_size_mb, max_hash_size_mb));
+        m_handler.send_raw(
+            std::format("option name EvalCache type spin default {} min {} max {}\n", EvalCache::default_size_mb, min_eval_cache_size_mb, max_eval_cache_size_mb)
+        );
+        m_handler.send_raw(std::format("option name Threads type spin default {} min {} max {}\n", SearchConfig{}.threads, min_threads, max_threads));
+    }
+
     auto is_white_to_move() -> bool { return m_engine.position().side_to_move() == chesscore::Color::White; }
 
     /**
@@ -0,0 +1,103 @@
+/* ************************************************************************** *
+ * Chess Engine Maat                                                          *
+ * Chess playing engine                                                       *
+ * ************************************************************************** */
+
+#ifndef CHESSENGINE_ZOBRIST_H
+#define CHESSENGINE_ZOBRIST_H
+
+#include "chessengine/types.h"
+
+#include <array>
+#include <cstdint>
+
+namespace chessengine {
+
+using HashKey = std::uint64_t; ///< Zobrist hash key of a position.
+
+constexpr std::size_t castling_rights_count{16}; ///< Number of combinations of castling rights.
+
+/**
+ * \brief Random numbers for the Zobrist hashing of positions.
+ *
+ * The key of a position is the XOR of the numbers for each piece on its
+ * square, the current castling rights, the file of a capturable en-passant
+ * target and the side to move (if black is to move).
+ *
+ * The material key of a position only depends on the number of pieces of each
+ * kind. It is the XOR of the numbers for the first, second, ... piece of each
+ * kind on the board.
+ */
+struct ZobristKeys {
+    std::array<std::array<HashKey, chesscore::Square::count>, piece_index_count> pieces{};   ///< Keys for the pieces on the squares.
+    std::array<HashKey, castling_rights_count> castling{};                                   ///< Keys for the castling rights.
+    std::array<HashKey, chesscore::File::count> en_passant{};                                ///< Keys for the file of the en-passant target.
+    HashKey black_to_move{};                                                                 ///< Key for black being the side to move.
+    std::array<std::array<HashKey, chesscore::Square::count>, piece_index_count> material{}; ///< Keys for the number of pieces of a kind.
+
+    /**
+     * \brief Key for a piece on a square.
+     *
+     * \param piece The piece.
+     * \param square The square.
+     * \return The key.
+     */
+    constexpr auto piece(chesscore::Piece piece, const chesscore::Square &square) const -> HashKey { return pieces[piece_index(piece)][square.index()]; }
+
+    /**
+     * \brief Key for a piece in the material key.
+     *
+     * \param piece The piece.
+     * \param count Number of pieces of the same kind already on the board.
+     * \return The key.
+     */
+    constexpr auto material_piece(chesscore::Piece piece, std::size_t count) const -> HashKey { return material[piece_index(piece)][count]; }
+};
+
+namespace detail {
+
+/**
+ * \brief SplitMix64 pseudo random number generator.
+ *
+ * Used to fill the Zobrist tables at compile time, so that the keys are the
+ * same on every platform.
+ * \param state The state of the generator.
+ * \return The next random number.
+ */
+constexpr auto splitmix64(std::uint64_t &state) -> std::uint64_t {
+    state += 0x9E3779B97F4A7C15ULL;
+    auto value = state;
+    value = (value ^ (value >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27U)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31U);
+}
+
+constexpr auto generate_zobrist_keys(std::uint64_t seed) -> ZobristKeys {
+    ZobristKeys keys{};
+    for (auto &piece_keys : keys.pieces) {
+        for (auto &key : piece_keys) {
+            key = splitmix64(seed);
+        }
+    }
+    for (auto &key : keys.castling) {
+        key = splitmix64(seed);
+    }
+    for (auto &key : keys.en_passant) {
+        key = splitmix64(seed);
+    }
+    keys.black_to_move = splitmix64(seed);
+    for (auto &piece_keys : keys.material) {
+        for (auto &key : piece_keys) {
+            key = splitmix64(seed);
+        }
+    }
+    return keys;
+}
+
+} // namespace detail
+
+inline constexpr ZobristKeys zobrist_keys = detail::generate_zobrist_keys(0x4D616174ULL); ///< The Zobrist keys used by the engine.
+
+} // namespace chessengine
+
+#endif
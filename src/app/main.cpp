@@ -3,14 +3,53 @@
  * Chess playing engine                                                       *
  * ************************************************************************** */
 
+#include "chessengine/bench.h"
 #include "chessengine/chess_engine.h"
 #include "chessengine/logger.h"
 #include "chessengine/uci_adapter.h"
 
 #include <iostream>
+#include <string>
 #include <thread>
 
+namespace {
+
+/**
+ * \brief Run the benchmark and print its result.
+ *
+ * Handles the command line "maat bench [depth] [--json]".
+ * \param argc Number of command line arguments.
+ * \param argv The command line arguments, the first one being "bench".
+ * \return Exit code of the program.
+ */
+auto bench(int argc, char *argv[]) -> int {
+    chessengine::BenchConfig config{};
+    bool json{false};
+    for (int i = 2; i < argc; ++i) {
+        const std::string arg{argv[i]};
+        if (arg == "--json") {
+            json = true;
+            continue;
+        }
+        const auto depth = chessengine::detail::parse_number<int>(arg);
+        if (!depth.has_value() || depth.value() < 1) {
+            std::cerr << "invalid argument '" << arg << "'\nusage: " << argv[0] << " bench [depth] [--json]\n";
+            return 1;
+        }
+        config.depth = depth.value();
+    }
+    const auto result = chessengine::run_bench(config);
+    std::cout << (json ? chessengine::to_json(result) : chessengine::to_string(result));
+    return 0;
+}
+
+} // namespace
+
 auto main(int argc, char *argv[]) -> int {
+    if (argc > 1 && std::string(argv[1]) == "bench") {
+        return bench(argc, argv);
+    }
+
     chessengine::UCIAdapter<chessengine::ChessEngine> uci_adapter{std::cin, std::cout};
 
     auto config = uci_adapter.engine().config();
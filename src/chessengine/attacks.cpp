@@ -0,0 +1,325 @@
+/* ************************************************************************** *
+ * Chess Engine Maat                                                          *
+ * Chess playing engine                                                       *
+ * ************************************************************************** */
+
+#include "chessengine/attacks.h"
+
+#include <array>
+#include <utility>
+
+#ifdef CHESSENGINE_USE_PEXT
+#include <immintrin.h>
+#endif
+
+namespace chessengine {
+
+namespace {
+
+using AttackTable = std::array<Bitboard, chesscore::Square::count>;
+
+/**
+ * \brief Squares reached by fixed steps from a square.
+ *
+ * Steps leaving the board are ignored.
+ * \param square Index of the start square.
+ * \param steps The steps as (file, rank) offsets.
+ * \return The reached squares.
+ */
+template<std::size_t N>
+constexpr auto step_targets(std::size_t square, const std::array<std::pair<int, int>, N> &steps) -> Bitboard {
+    const auto file = static_cast<int>(square % 8);
+    const auto rank = static_cast<int>(square / 8);
+    Bitboard targets{0};
+    for (const auto &[file_step, rank_step] : steps) {
+        const auto target_file = file + file_step;
+        const auto target_rank = rank + rank_step;
+        if (target_file >= 0 && target_file < 8 && target_rank >= 0 && target_rank < 8) {
+            targets |= square_bit(static_cast<std::size_t>(target_rank * 8 + target_file));
+        }
+    }
+    return targets;
+}
+
+template<std::size_t N>
+constexpr auto step_table(const std::array<std::pair<int, int>, N> &steps) -> AttackTable {
+    AttackTable table{};
+    for (std::size_t square = 0; square < table.size(); ++square) {
+        table[square] = step_targets(square, steps);
+    }
+    return table;
+}
+
+constexpr std::array<std::pair<int, int>, 8> knight_steps{{{1, 2}, {2, 1}, {2, -1}, {1, -2}, {-1, -2}, {-2, -1}, {-2, 1}, {-1, 2}}};
+constexpr std::array<std::pair<int, int>, 8> king_steps{{{0, 1}, {1, 1}, {1, 0}, {1, -1}, {0, -1}, {-1, -1}, {-1, 0}, {-1, 1}}};
+constexpr std::array<std::pair<int, int>, 2> white_pawn_steps{{{-1, 1}, {1, 1}}};
+constexpr std::array<std::pair<int, int>, 2> black_pawn_steps{{{-1, -1}, {1, -1}}};
+constexpr std::array<std::pair<int, int>, 4> bishop_directions{{{1, 1}, {1, -1}, {-1, -1}, {-1, 1}}};
+constexpr std::array<std::pair<int, int>, 4> rook_directions{{{0, 1}, {1, 0}, {0, -1}, {-1, 0}}};
+
+constexpr AttackTable knight_table = step_table(knight_steps);
+constexpr AttackTable king_table = step_table(king_steps);
+constexpr std::array<AttackTable, 2> pawn_table{step_table(white_pawn_steps), step_table(black_pawn_steps)};
+
+/**
+ * \brief Squares attacked along lines from a square.
+ *
+ * Each line ends at the first occupied square, which is included. This is
+ * the slow reference implementation, that is used to fill the attack tables.
+ * \param square Index of the start square.
+ * \param occupied The occupied squares.
+ * \param directions The directions of the lines as (file, rank) steps.
+ * \return The attacked squares.
+ */
+auto slider_attacks(std::size_t square, Bitboard occupied, const std::array<std::pair<int, int>, 4> &directions) -> Bitboard {
+    Bitboard attacks{0};
+    for (const auto &[file_step, rank_step] : directions) {
+        auto file = static_cast<int>(square % 8) + file_step;
+        auto rank = static_cast<int>(square / 8) + rank_step;
+        while (file >= 0 && file < 8 && rank >= 0 && rank < 8) {
+            const auto target = square_bit(static_cast<std::size_t>(rank * 8 + file));
+            attacks |= target;
+            if ((occupied & target) != 0) {
+                break;
+            }
+            file += file_step;
+            rank += rank_step;
+        }
+    }
+    return attacks;
+}
+
+/**
+ * \brief Lookup of the attacks of a sliding piece on one square.
+ *
+ * Only the occupied squares within the mask can block the attacks. They are
+ * mapped to an index into the attack table, either by multiplying with a
+ * magic number and keeping the upper bits of the product, or by extracting
+ * the masked bits with the PEXT instruction.
+ */
+struct SliderEntry {
+    Bitboard mask{0};      ///< Squares that can block the attacks; the last square of each line is excluded.
+    Bitboard magic{0};     ///< Multiplier that maps each subset of the mask to a distinct index (unused with PEXT).
+    unsigned shift{0};     ///< 64 minus the number of squares in the mask.
+    std::size_t offset{0}; ///< Start of the attacks of the square in the attack table.
+
+    auto index(Bitboard occupied) const -> std::size_t {
+#ifdef CHESSENGINE_USE_PEXT
+        return offset + static_cast<std::size_t>(_pext_u64(occupied, mask));
+#else
+        return offset + static_cast<std::size_t>(((occupied & mask) * magic) >> shift);
+#endif
+    }
+};
+
+/**
+ * \brief Attack lookup for one type of sliding piece.
+ *
+ * \tparam TableSize Sum of the number of subsets of the masks of all squares.
+ */
+template<std::size_t TableSize>
+struct SliderTable {
+    std::array<SliderEntry, chesscore::Square::count> entries{}; ///< Lookup information by square.
+    std::array<Bitboard, TableSize> attacks{};                   ///< Attacks for each square and subset of its mask.
+
+    auto lookup(std::size_t square, Bitboard occupied) const -> Bitboard { return attacks[entries[square].index(occupied)]; }
+};
+
+SliderTable<5248> bishop_table{};
+SliderTable<102400> rook_table{};
+std::array<AttackTable, chesscore::Square::count> between_table{};
+std::array<AttackTable, chesscore::Square::count> line_table{};
+
+// The magic numbers were found by trial and error with sparse random numbers. Each maps all subsets of
+// the mask of its square to indices without destructive collisions (different attacks on the same index).
+/// Magic numbers for the bishop attacks by square.
+constexpr std::array<Bitboard, chesscore::Square::count> bishop_magics{
+    0x0C40484094008020ULL, 0x00A2500451024180ULL, 0x0021010C00830003ULL, 0x1009240100400010ULL,
+    0x5604042100800C02ULL, 0x020310180C000284ULL, 0x020C010813300210ULL, 0x4001012210044440ULL,
+    0x0032124208180090ULL, 0xC000245004510020ULL, 0x08AD9040A2044202ULL, 0x0000212040800208ULL,
+    0x0000840308042100ULL, 0x8420820804060000ULL, 0x5000010430028800ULL, 0x0A00090401412840ULL,
+    0x0A40044848980080ULL, 0x8020081044410044ULL, 0x09240A0820202200ULL, 0x1008000082004029ULL,
+    0x0851000820080000ULL, 0x1001000200410400ULL, 0x204400020084C400ULL, 0x1481000041080124ULL,
+    0x0064048040082838ULL, 0x001128255010810CULL, 0x0400E60210040840ULL, 0x20820024180080A0ULL,
+    0x4001001001004020ULL, 0x601101000808A800ULL, 0x0404148800480400ULL, 0x080C002026410C2AULL,
+    0xA092200402115004ULL, 0x8002029010208114ULL, 0x4004109000080042ULL, 0x1C00400820020200ULL,
+    0x000C0B0400060082ULL, 0x0248100C08704100ULL, 0x28B00200808220A0ULL, 0x0801010104102C00ULL,
+    0x1000900410012200ULL, 0x000C04829010A800ULL, 0x0021202030005801ULL, 0x000001A018000900ULL,
+    0x0101200410400400ULL, 0x1901017000802100ULL, 0x0182420404005128ULL, 0x085011020482402EULL,
+    0x008400A844100010ULL, 0x0402404818081002ULL, 0x2010010088D00000ULL, 0x2020040042020411ULL,
+    0x0022006020248000ULL, 0x0000082108008000ULL, 0x04100288080882A0ULL, 0x4190240844802072ULL,
+    0x0800802082202010ULL, 0x2018811404A20800ULL, 0x0200006042009002ULL, 0x0024105800840C40ULL,
+    0x0235800420020484ULL, 0x0000010820080090ULL, 0x0604106028210041ULL, 0x8082105008910040ULL,
+};
+
+/// Magic numbers for the rook attacks by square.
+constexpr std::array<Bitboard, chesscore::Square::count> rook_magics{
+    0x0080004000208011ULL, 0x2100102100804000ULL, 0x0080200080100008ULL, 0x0680061000800800ULL,
+    0x0200100200082004ULL, 0x2200010402001008ULL, 0x0080020000800100ULL, 0x0100002100038052ULL,
+    0x0000802040008000ULL, 0x0011002100804000ULL, 0x1210802000801008ULL, 0x0101000C20100101ULL,
+    0x0040808008000400ULL, 0x2202800400800200ULL, 0x0091003200110004ULL, 0x0490800040800100ULL,
+    0x508000C000200048ULL, 0x04E0004000300041ULL, 0x0030008010802000ULL, 0x1010008010800800ULL,
+    0x401C808008000400ULL, 0x0984008080040200ULL, 0x02000400C1121008ULL, 0x0020020024488104ULL,
+    0x4940802080004002ULL, 0x00C0100140200042ULL, 0x0002124100200101ULL, 0x8900084200201201ULL,
+    0x0008050100100800ULL, 0x0024000480800200ULL, 0x00081014002E0841ULL, 0x0400008200012844ULL,
+    0x4080002000400040ULL, 0x000080400080200AULL, 0x0010008010802000ULL, 0x0048041000800881ULL,
+    0x0000041101000800ULL, 0x0002000280800400ULL, 0x0202482104001012ULL, 0x0000440082000041ULL,
+    0x0180400080008020ULL, 0x9120005000204002ULL, 0x8088420082160020ULL, 0x0810100008008080ULL,
+    0x0001020800850010ULL, 0x6000400410680120ULL, 0x0090583002040081ULL, 0x10000100A0420004ULL,
+    0x8800804200210200ULL, 0x1000400880200480ULL, 0x4602028040201A00ULL, 0x1008801000480180ULL,
+    0x0000040080080080ULL, 0x0040040002008080ULL, 0x0020A20108104400ULL, 0x000104650C008200ULL,
+    0x2300800020190041ULL, 0x0004A481014001D7ULL, 0x8024204208120082ULL, 0x0029000905201001ULL,
+    0x4003000230480005ULL, 0xC101000208040001ULL, 0x0008421001080084ULL, 0x1120502084010052ULL,
+};
+
+/**
+ * \brief Fill the attack lookup of a sliding piece type.
+ *
+ * For each square, all subsets of the blocker mask are enumerated (carry-rippler)
+ * and their attacks are computed with the reference implementation.
+ * \param table The lookup to fill.
+ * \param directions The directions of the piece's lines.
+ * \param magics The magic numbers by square.
+ */
+template<std::size_t TableSize>
+auto init_slider_table(
+    SliderTable<TableSize> &table, const std::array<std::pair<int, int>, 4> &directions, [[maybe_unused]] const std::array<Bitboard, chesscore::Square::count> &magics
+) -> void {
+    constexpr Bitboard rank_edges{0xFF000000000000FFULL};
+    constexpr Bitboard file_edges{0x8181818181818181ULL};
+
+    std::size_t offset{0};
+    for (std::size_t square = 0; square < table.entries.size(); ++square) {
+        auto &entry = table.entries[square];
+        // The squares on the edges never block, unless the piece is on that edge itself.
+        const auto edges = (rank_edges & ~(Bitboard{0xFF} << (8 * (square / 8)))) | (file_edges & ~(Bitboard{0x0101010101010101ULL} << (square % 8)));
+        entry.mask = slider_attacks(square, 0, directions) & ~edges;
+        entry.shift = static_cast<unsigned>(64 - std::popcount(entry.mask));
+        entry.offset = offset;
+#ifndef CHESSENGINE_USE_PEXT
+        entry.magic = magics[square];
+#endif
+        Bitboard subset{0};
+        do {
+            table.attacks[entry.index(subset)] = slider_attacks(square, subset, directions);
+            subset = (subset - entry.mask) & entry.mask;
+        } while (subset != 0);
+        offset += std::size_t{1} << std::popcount(entry.mask);
+    }
+}
+
+/**
+ * \brief Fill the tables of squares between and on the line through two squares.
+ *
+ * The slider tables have to be filled before.
+ */
+auto init_line_tables() -> void {
+    for (std::size_t from = 0; from < chesscore::Square::count; ++from) {
+        for (std::size_t to = 0; to < chesscore::Square::count; ++to) {
+            const auto endpoints = square_bit(from) | square_bit(to);
+            if (from == to) {
+                continue;
+            }
+            if ((bishop_table.lookup(from, 0) & square_bit(to)) != 0) {
+                line_table[from][to] = (bishop_table.lookup(from, 0) & bishop_table.lookup(to, 0)) | endpoints;
+                between_table[from][to] = bishop_table.lookup(from, square_bit(to)) & bishop_table.lookup(to, square_bit(from));
+            } else if ((rook_table.lookup(from, 0) & square_bit(to)) != 0) {
+                line_table[from][to] = (rook_table.lookup(from, 0) & rook_table.lookup(to, 0)) | endpoints;
+                between_table[from][to] = rook_table.lookup(from, square_bit(to)) & rook_table.lookup(to, square_bit(from));
+            }
+        }
+    }
+}
+
+/// The tables are filled during static initialization; they must not be used by other static initializers.
+[[maybe_unused]] const bool tables_initialized = [] {
+    init_slider_table(bishop_table, bishop_directions, bishop_magics);
+    init_slider_table(rook_table, rook_directions, rook_magics);
+    init_line_tables();
+    return true;
+}();
+
+} // namespace
+
+auto knight_attacks(std::size_t square) -> Bitboard {
+    return knight_table[square];
+}
+
+auto king_attacks(std::size_t square) -> Bitboard {
+    return king_table[square];
+}
+
+auto pawn_attacks(chesscore::Color color, std::size_t square) -> Bitboard {
+    return pawn_table[color == chesscore::Color::White ? 0 : 1][square];
+}
+
+auto bishop_attacks(std::size_t square, Bitboard occupied) -> Bitboard {
+    return bishop_table.lookup(square, occupied);
+}
+
+auto rook_attacks(std::size_t square, Bitboard occupied) -> Bitboard {
+    return rook_table.lookup(square, occupied);
+}
+
+auto between_squares(std::size_t from, std::size_t to) -> Bitboard {
+    return between_table[from][to];
+}
+
+auto line_through(std::size_t from, std::size_t to) -> Bitboard {
+    return line_table[from][to];
+}
+
+BoardBitboards::BoardBitboards(const chesscore::Position &position) {
+    const auto &board = position.board();
+    for (int rank = 0; rank < chesscore::Rank::count; ++rank) {
+        for (int file = 0; file < chesscore::File::count; ++file) {
+            const chesscore::Square square{file, rank};
+            const auto piece = board.get_piece(square);
+            if (piece.has_value()) {
+                const auto bit = square_bit(square.index());
+                m_colors[piece->color() == chesscore::Color::White ? 0 : 1] |= bit;
+                m_types[get_index(piece->type())] |= bit;
+            }
+        }
+    }
+}
+
+auto BoardBitboards::piece_on(std::size_t square) const -> std::optional<chesscore::Piece> {
+    const auto bit = square_bit(square);
+    if ((occupied() & bit) == 0) {
+        return std::nullopt;
+    }
+    const auto color = (m_colors[0] & bit) != 0 ? chesscore::Color::White : chesscore::Color::Black;
+    for (const auto type : chesscore::all_piece_types) {
+        if ((m_types[get_index(type)] & bit) != 0) {
+            return chesscore::Piece{type, color};
+        }
+    }
+    return std::nullopt;
+}
+
+auto BoardBitboards::attackers_to(std::size_t square, Bitboard occupied) const -> Bitboard {
+    const auto diagonal_sliders = pieces(chesscore::PieceType::Bishop) | pieces(chesscore::PieceType::Queen);
+    const auto straight_sliders = pieces(chesscore::PieceType::Rook) | pieces(chesscore::PieceType::Queen);
+    const auto pawns = pieces(chesscore::PieceType::Pawn);
+    // A pawn attacks the square, if a pawn of the other color on the square would attack the pawn.
+    const auto attackers = (pawn_attacks(chesscore::Color::Black, square) & pawns & pieces(chesscore::Color::White)) |
+                           (pawn_attacks(chesscore::Color::White, square) & pawns & pieces(chesscore::Color::Black)) |
+                           (knight_attacks(square) & pieces(chesscore::PieceType::Knight)) | (king_attacks(square) & pieces(chesscore::PieceType::King)) |
+                           (bishop_attacks(square, occupied) & diagonal_sliders) | (rook_attacks(square, occupied) & straight_sliders);
+    return attackers & occupied;
+}
+
+auto BoardBitboards::in_check(chesscore::Color color) const -> bool {
+    const auto king = pieces(chesscore::PieceType::King) & pieces(color);
+    if (king == 0) {
+        return false;
+    }
+    return (attackers_to(lowest_square(king), occupied()) & pieces(chesscore::other_color(color))) != 0;
+}
+
+auto is_in_check(const chesscore::Position &position) -> bool {
+    return BoardBitboards{position}.in_check(position.side_to_move());
+}
+
+} // namespace chessengine
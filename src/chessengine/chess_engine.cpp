@@ -6,12 +6,16 @@
 #include "chessengine/chess_engine.h"
 #include "chessengine/logger.h"
 
+#include <algorithm>
+#include <iterator>
+
 namespace chessengine {
 
 const char ChessEngine::identifier[] = "Maat v0.1";
 const char ChessEngine::author[] = "Florian Giesemann";
 
-ChessEngine::ChessEngine(const Config &config) : m_config{config}, m_evaluator{config.evaluator_config} {}
+ChessEngine::ChessEngine(const Config &config)
+    : m_config{config}, m_evaluator{config.evaluator_config}, m_transposition_table{config.search_config.hash_size_mb} {}
 
 ChessEngine::~ChessEngine() {
     if (m_search_thread.joinable()) {
@@ -22,151 +26,143 @@ ChessEngine::~ChessEngine() {
 auto ChessEngine::search(const StopParameters &stop_params) -> EvaluatedMove {
     log_search_stream() << "Searching position:";
     if (Logger::instance().is_enabled()) {
-        const auto fen = chesscore::FenString{m_position.piece_placement(), m_position.state()}.str();
+        const auto fen = chesscore::FenString{position().piece_placement(), position().state()}.str();
         log_search_stream() << "  fen = " << fen;
         log_search_stream() << "  stopping criteria: " << to_string(stop_params);
+        log_search_stream() << "  threads: " << m_config.search_config.threads;
     }
     m_search_start = std::chrono::steady_clock::now();
-    m_stopping_params = stop_params;
-    // If iterative_deepening is not used, the max_search_depth should be set!
-    auto search_depth = m_config.search_config.iterative_deepening ? Depth{1} : stop_params.max_search_depth;
+    m_transposition_table.new_search();
+    m_shared_state.stop = false;
+    m_shared_state.helper_nodes = 0;
     m_best_move = {};
-    try {
-        while (true) {
-            check_stop();
-            log_search_stream() << "Searching for depth: " << search_depth;
-            log_indent();
-            m_best_move = search_position(search_depth);
-            log_unindent();
-            log_search_stream() << "Search for depth " << search_depth << " finishd with best move: " << to_string(m_best_move.move) << " (" << m_best_move.score << ')';
-            m_search_stats.depth = search_depth;
-            if (m_search_progress_callback) {
-                m_search_stats.best_move = m_best_move;
-                m_search_stats.elapsed_time = search_time();
-                m_search_progress_callback(m_search_stats);
-            }
-            if (is_winning_score(m_best_move.score)) {
-                log_search_stream() << "Stopping search at winning score " << m_best_move.score;
-                break;
-            }
-            search_depth += Depth::Step;
+    auto worker_stop_params = stop_params;
+    if (stop_params.mate_in_moves > 0) {
+        if (solve_mate(stop_params)) {
+            return finish_search();
+        }
+        if (worker_stop_params.max_search_depth == Depth::Zero) {
+            worker_stop_params.max_search_depth = Depth{static_cast<Depth::value_type>(2 * stop_params.mate_in_moves)};
         }
-    } catch (const SearchAborted &e) {
-        log_search_stream() << "Search stopped: " << e.what();
     }
+    prepare_workers();
+    for (auto &worker : m_workers) {
+        worker->prepare(m_position, worker_stop_params, m_search_start);
+    }
+
+    std::vector<std::thread> helper_threads;
+    helper_threads.reserve(m_workers.size() - 1);
+    for (auto it = std::next(m_workers.begin()); it != m_workers.end(); ++it) {
+        helper_threads.emplace_back(&SearchWorker::search, it->get());
+    }
+    auto deadline_timer = start_deadline_timer(stop_params.max_search_time);
+    m_workers.front()->search();
+    {
+        std::scoped_lock lock{m_timer_mutex};
+        m_shared_state.stop = true;
+    }
+    m_timer_signal.notify_all();
+    for (auto &thread : helper_threads) {
+        thread.join();
+    }
+    if (deadline_timer.joinable()) {
+        deadline_timer.join();
+    }
+    collect_results();
+    return finish_search();
+}
 
+auto ChessEngine::solve_mate(const StopParameters &stop_params) -> bool {
+    log_search_stream() << "Solving for mate in " << stop_params.mate_in_moves;
+    const auto search_stats = m_mate_solver.solve(m_position, stop_params.mate_in_moves, stop_params, m_search_start);
+    if (!is_winning_score(search_stats.best_move.score)) {
+        log_search_stream() << "No mate found (" << search_stats.nodes << " nodes)";
+        return false;
+    }
+    m_search_stats = search_stats;
+    m_best_move = search_stats.best_move;
+    if (m_search_progress_callback) {
+        m_search_progress_callback(m_search_stats);
+    }
+    return true;
+}
+
+auto ChessEngine::finish_search() -> EvaluatedMove {
     m_search_running = false;
-    m_search_stats.elapsed_time = search_time();
     log_search_stream() << "Search took " << m_search_stats.elapsed_time.count() << " ms";
+    log_search_stream() << "Pawn hash hit rate: " << m_search_stats.pawn_hash_hit_rate();
+    log_search_stream() << "Eval cache hit rate: " << m_search_stats.eval_cache_hit_rate();
     if (m_search_ended_callback) {
         m_search_ended_callback(m_best_move);
     }
     return m_best_move;
 }
 
-auto ChessEngine::search_position(Depth depth) -> EvaluatedMove {
-    EvaluatedMove best_move{.move = {}, .score = Score::NegInfinity};
-    Bounds bounds{};
-    const auto moves = moves_to_search(m_config.search_config.search_pv_first && depth > Depth::Step);
-    log_search_stream() << "Searching " << moves.size() << " moves for " << to_string(m_position.side_to_move()) << ": " << to_string(moves);
-    for (const auto &move : moves) {
-        {
-            log_search_stream() << "Checking move " << to_string(move) << " for " << to_string(m_position.side_to_move()) << " at depth " << depth;
-            log_indent();
-            MoveScope scope{m_position, move};
-            auto value = -search_position(depth - Depth::Step, bounds.swap());
-            log_unindent();
-            log_search_stream() << "Move " << to_string(move) << " for " << to_string(m_position.side_to_move()) << " evaluated to " << value;
-            if (is_winning_score(value)) {
-                value = value - Depth::Step;
-            } else if (is_losing_score(value)) {
-                value = value + Depth::Step;
-            }
-            if (value > best_move.score) {
-                log_search_stream() << "Found new best move for " << to_string(m_position.side_to_move()) << ": " << to_string(move) << " (" << value << ") replacing "
-                                    << to_string(best_move.move) << " (" << best_move.score << ")";
-                best_move = {.move = move, .score = value};
-            }
-        }
-        bounds.alpha = std::max(bounds.alpha, best_move.score);
-        if (m_config.minimax_config.use_alpha_beta_pruning && (bounds.beta <= bounds.alpha)) {
-            log_search("Cancelling search");
-            m_search_stats.cutoffs += 1;
-            break;
-        }
-        check_stop();
-    }
-    m_search_stats.nodes += 1;
-
-    return best_move;
-}
-
-auto ChessEngine::search_position(Depth depth, Bounds bounds) -> Score {
-    if ((depth == Depth::Zero)) {
-        const auto eval = m_evaluator.evaluate(m_position, m_position.side_to_move());
-        log_search_stream() << "Search stopped by depth. Position evaluation: " << eval;
-        return eval;
-    }
-
-    const auto moves = moves_to_search();
-    if (moves.empty()) {
-        const auto eval = m_evaluator.evaluate(m_position, m_position.side_to_move());
-        log_search_stream() << "No moves to search. Position evaluation: " << eval;
-        m_search_stats.nodes += 1;
-        return eval;
-    }
-
-    log_search_stream() << "Searching " << moves.size() << " moves for " << to_string(m_position.side_to_move()) << ": " << to_string(moves);
-    log_search_stream() << "Alpha = " << bounds.alpha << " Beta = " << bounds.beta;
-
-    auto best_value = Score::NegInfinity;
-    for (const auto &move : moves) {
-        check_stop();
-        log_search_stream() << "Checking move " << to_string(move) << " for " << to_string(m_position.side_to_move()) << " at depth " << depth;
-        {
-            log_indent();
-            MoveScope scope{m_position, move};
-            auto value = -search_position(depth - Depth::Step, bounds.swap());
-            log_unindent();
-            log_search_stream() << "Move " << to_string(move) << " for " << to_string(m_position.side_to_move()) << " evaluated to " << value;
-            if (is_winning_score(value)) {
-                value = value - Depth::Step;
-            } else if (is_losing_score(value)) {
-                value = value + Depth::Step;
-            }
-            best_value = std::max(best_value, value);
-            if (bounds.alpha < best_value) {
-                log_search_stream() << "Updated alpha from " << bounds.alpha << " to " << best_value << "; beta = " << bounds.beta;
-            }
-        }
-        bounds.alpha = std::max(bounds.alpha, best_value);
-        if (m_config.minimax_config.use_alpha_beta_pruning && (bounds.beta <= bounds.alpha)) {
-            log_search("Cancelling search");
-            m_search_stats.cutoffs += 1;
-            break;
+auto ChessEngine::start_deadline_timer(std::chrono::milliseconds max_search_time) -> std::thread {
+    if (max_search_time.count() <= 0 || max_search_time == std::chrono::milliseconds::max()) {
+        return std::thread{};
+    }
+    return std::thread{[this, deadline = m_search_start + max_search_time]() -> void {
+        std::unique_lock lock{m_timer_mutex};
+        if (!m_timer_signal.wait_until(lock, deadline, [this]() -> bool { return m_shared_state.stop.load(); })) {
+            log_search("STOPPING. Max search time exceeded");
+            m_shared_state.stop = true;
         }
+    }};
+}
+
+auto ChessEngine::prepare_workers() -> void {
+    const auto thread_count = std::max<std::size_t>(m_config.search_config.threads, 1);
+    while (m_workers.size() > thread_count) {
+        m_workers.pop_back();
+    }
+    while (m_workers.size() < thread_count) {
+        m_workers.push_back(
+            std::make_unique<SearchWorker>(static_cast<int>(m_workers.size()), m_config, m_evaluator, m_transposition_table, m_shared_state, m_stop_requested)
+        );
     }
-    m_search_stats.nodes += 1;
-    return best_value;
+    m_workers.front()->on_progress([this](const SearchStats &worker_stats) -> void { report_progress(worker_stats); });
 }
 
-auto ChessEngine::moves_to_search(bool search_principal_variation_first) const -> chesscore::MoveList {
-    auto moves = m_position.all_legal_moves();
-    if (m_config.minimax_config.use_move_ordering) {
-        sort_moves(moves);
-        if (search_principal_variation_first) {
-            auto it = std::find(moves.begin(), moves.end(), m_best_move.move);
-            if (it != moves.end()) {
-                log_search("Move ordering: moving best move of previous iteration to front");
-                std::rotate(moves.begin(), it, it + 1);
-            }
-        }
+auto ChessEngine::report_progress(const SearchStats &worker_stats) -> void {
+    if (worker_stats.score_bound == ScoreBound::Exact) {
+        m_best_move = worker_stats.best_move;
+    }
+    if (m_search_progress_callback) {
+        auto search_stats = worker_stats;
+        search_stats.nodes += m_shared_state.helper_nodes.load(std::memory_order_relaxed);
+        m_search_progress_callback(search_stats);
     }
-    return moves;
 }
 
-auto ChessEngine::sort_moves(chesscore::MoveList &moves) const -> void {
-    std::ranges::sort(moves, [this](const chesscore::Move &lhs, const chesscore::Move &rhs) -> bool { return m_evaluator.evaluate(lhs) > m_evaluator.evaluate(rhs); });
+auto ChessEngine::collect_results() -> void {
+    const SearchWorker *best_worker = m_workers.front().get();
+    SearchStats search_stats{};
+    for (const auto &worker : m_workers) {
+        const auto &worker_stats = worker->search_stats();
+        search_stats.nodes += worker_stats.nodes;
+        search_stats.qnodes += worker_stats.qnodes;
+        search_stats.cutoffs += worker_stats.cutoffs;
+        search_stats.tt_hits += worker_stats.tt_hits;
+        search_stats.first_move_cutoffs += worker_stats.first_move_cutoffs;
+        search_stats.reduced_moves += worker_stats.reduced_moves;
+        search_stats.re_searches += worker_stats.re_searches;
+        search_stats.pawn_hash_probes += worker_stats.pawn_hash_probes;
+        search_stats.pawn_hash_hits += worker_stats.pawn_hash_hits;
+        search_stats.eval_cache_probes += worker_stats.eval_cache_probes;
+        search_stats.eval_cache_hits += worker_stats.eval_cache_hits;
+        if (worker->completed_depth() > best_worker->completed_depth()) {
+            best_worker = worker.get();
+        }
+    }
+    if (best_worker != m_workers.front().get()) {
+        log_search_stream() << "Taking best move from helper thread " << best_worker->id() << " at depth " << best_worker->completed_depth();
+    }
+    m_best_move = best_worker->best_move();
+    search_stats.best_move = m_best_move;
+    search_stats.depth = best_worker->completed_depth();
+    search_stats.elapsed_time = search_time();
+    m_search_stats = search_stats;
 }
 
 auto ChessEngine::search_stats() const -> const SearchStats & {
@@ -174,7 +170,9 @@ auto ChessEngine::search_stats() const -> const SearchStats & {
 }
 
 auto ChessEngine::new_game() -> void {
-    m_position = chesscore::Position{chesscore::FenString::starting_position()};
+    m_position.set_position(chesscore::Position{chesscore::FenString::starting_position()});
+    m_transposition_table.clear();
+    m_mate_solver.clear();
 }
 
 auto ChessEngine::start_search(const StopParameters &stop_params) -> void {
@@ -194,7 +192,7 @@ auto ChessEngine::stop_search() -> void {
 }
 
 auto ChessEngine::set_position(const chesscore::Position &position) -> void {
-    m_position = position;
+    m_position.set_position(position);
 }
 
 auto ChessEngine::play_move(const chesscore::Move &move) -> void {
@@ -205,38 +203,19 @@ auto ChessEngine::set_debugging(bool debug_on) -> void {
     m_debugging = debug_on;
 }
 
+auto ChessEngine::set_config(const Config &config) -> void {
+    m_config = config;
+    if (m_transposition_table.size_mb() != m_config.search_config.hash_size_mb) {
+        m_transposition_table.resize(m_config.search_config.hash_size_mb);
+    }
+}
+
 auto ChessEngine::load_config(const std::filesystem::path &filename) -> void {
-    m_config = Config::from_file(filename);
+    set_config(Config::from_file(filename));
 }
 
 auto ChessEngine::search_time() const -> std::chrono::milliseconds {
     return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - m_search_start);
 }
 
-auto ChessEngine::check_stop() const -> void {
-    static int check_counter{0};
-
-    if (m_stop_requested) {
-        log_search("STOPPING. Stop requested");
-        throw SearchAborted("user request");
-    }
-    if (m_stopping_params.max_search_depth > Depth::Zero && m_search_stats.depth > m_stopping_params.max_search_depth) {
-        log_search("STOPPING. Max search depth reached");
-        throw SearchAborted("max search depth reached");
-    }
-    if (m_stopping_params.max_search_nodes > 0 && m_search_stats.nodes > m_stopping_params.max_search_nodes) {
-        log_search("STOPPING. Max search nodes reached");
-        throw SearchAborted("max search nodes reached");
-    }
-    if ((m_stopping_params.max_search_time.count() > 0) && (++check_counter > stop_check_interval)) {
-        check_counter = 0;
-        const auto search_duration = search_time();
-        const auto time_exceeded = search_duration > m_stopping_params.max_search_time;
-        if (time_exceeded) {
-            log_search("STOPPING. Max search time exceeded");
-            throw SearchAborted("max search time exceeded");
-        }
-    }
-}
-
 } // namespace chessengine
@@ -0,0 +1,281 @@
+/* ************************************************************************** *
+ * Chess Engine Maat                                                          *
+ * Chess playing engine                                                       *
+ * ************************************************************************** */
+
+#include "chessengine/engine_position.h"
+#include "chessengine/move_generator.h"
+
+#include <chesscore/fen.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+
+namespace chessengine {
+
+namespace {
+
+constexpr std::uint8_t all_castling_rights{EnginePosition::white_kingside | EnginePosition::white_queenside | EnginePosition::black_kingside | EnginePosition::black_queenside};
+constexpr int fifty_move_plies{100}; ///< Plies without capture or pawn move until the game is drawn.
+
+auto file_of(const chesscore::Square &square) -> int {
+    return static_cast<int>(square.index()) % chesscore::File::count;
+}
+
+auto rank_of(const chesscore::Square &square) -> int {
+    return static_cast<int>(square.index()) / chesscore::File::count;
+}
+
+/**
+ * \brief Castling rights that remain, when a piece moves from or to a square.
+ *
+ * Moving the king or a rook, or capturing a rook on its initial square,
+ * removes the corresponding castling rights.
+ * \param square The square.
+ * \return Mask of castling rights that are kept.
+ */
+auto castling_mask(const chesscore::Square &square) -> std::uint8_t {
+    switch (square.index()) {
+    case 0:
+        return all_castling_rights & ~EnginePosition::white_queenside;
+    case 4:
+        return all_castling_rights & ~(EnginePosition::white_kingside | EnginePosition::white_queenside);
+    case 7:
+        return all_castling_rights & ~EnginePosition::white_kingside;
+    case 56:
+        return all_castling_rights & ~EnginePosition::black_queenside;
+    case 60:
+        return all_castling_rights & ~(EnginePosition::black_kingside | EnginePosition::black_queenside);
+    case 63:
+        return all_castling_rights & ~EnginePosition::black_kingside;
+    default:
+        return all_castling_rights;
+    }
+}
+
+auto parse_castling_rights(const std::string &castling) -> std::uint8_t {
+    std::uint8_t rights{0};
+    for (const char right : castling) {
+        switch (right) {
+        case 'K':
+            rights |= EnginePosition::white_kingside;
+            break;
+        case 'Q':
+            rights |= EnginePosition::white_queenside;
+            break;
+        case 'k':
+            rights |= EnginePosition::black_kingside;
+            break;
+        case 'q':
+            rights |= EnginePosition::black_queenside;
+            break;
+        default:
+            break;
+        }
+    }
+    return rights;
+}
+
+} // namespace
+
+auto EnginePosition::set_position(const chesscore::Position &position) -> void {
+    m_position = position;
+    m_history.clear();
+    m_null_moves = 0;
+    m_state = State{};
+    m_state.side_to_move = m_position.side_to_move();
+    for (int rank = 0; rank < chesscore::Rank::count; ++rank) {
+        for (int file = 0; file < chesscore::File::count; ++file) {
+            const chesscore::Square square{file, rank};
+            const auto piece = m_position.board().get_piece(square);
+            if (piece.has_value()) {
+                toggle_piece(piece.value(), square);
+            }
+        }
+    }
+
+    // Castling rights and en-passant target are only accessible through the FEN representation.
+    const auto fen = chesscore::FenString{m_position.piece_placement(), m_position.state()}.str();
+    std::istringstream fields{fen};
+    std::string placement;
+    std::string side;
+    std::string castling;
+    std::string en_passant;
+    int halfmove_clock{0};
+    fields >> placement >> side >> castling >> en_passant >> halfmove_clock;
+
+    m_state.halfmove_clock = static_cast<std::uint16_t>(std::max(halfmove_clock, 0));
+    m_state.reversible_plies = m_state.halfmove_clock;
+    m_state.key ^= zobrist_keys.castling[0];
+    set_castling(parse_castling_rights(castling));
+    if (en_passant.size() == 2) {
+        const auto file = en_passant[0] - 'a';
+        if (en_passant_capturable(file)) {
+            set_en_passant(static_cast<std::int8_t>(file));
+        }
+    }
+    if (side_to_move() == chesscore::Color::Black) {
+        m_state.key ^= zobrist_keys.black_to_move;
+    }
+}
+
+auto EnginePosition::set_piece_square_values(const PieceSquareValues *values) -> void {
+    m_piece_square_values = values;
+    m_state.eval = compute_evaluation_terms(m_state.board);
+    for (auto &state : m_history) {
+        state.eval = compute_evaluation_terms(state.board);
+    }
+}
+
+auto EnginePosition::make_move(const chesscore::Move &move) -> void {
+    m_history.push_back(m_state);
+    if (move.is_capture() || move.piece.type() == chesscore::PieceType::Pawn) {
+        m_state.halfmove_clock = 0;
+        m_state.reversible_plies = 0;
+    } else {
+        ++m_state.halfmove_clock;
+        ++m_state.reversible_plies;
+    }
+
+    if (move.captured.has_value()) {
+        // An en-passant capture is the only capture to an empty square.
+        const auto en_passant = (m_state.board.occupied() & square_bit(move.to.index())) == 0;
+        toggle_piece(move.captured.value(), en_passant ? chesscore::Square{file_of(move.to), rank_of(move.from)} : move.to);
+    }
+    toggle_piece(move.piece, move.from);
+    toggle_piece(move.promoted.value_or(move.piece), move.to);
+
+    const auto from_file = file_of(move.from);
+    const auto to_file = file_of(move.to);
+    if (move.piece.type() == chesscore::PieceType::King && std::abs(to_file - from_file) == 2) {
+        const auto kingside = to_file > from_file;
+        const auto rank = rank_of(move.from);
+        const chesscore::Piece rook{chesscore::PieceType::Rook, move.piece.color()};
+        toggle_piece(rook, chesscore::Square{kingside ? 7 : 0, rank});
+        toggle_piece(rook, chesscore::Square{kingside ? 5 : 3, rank});
+    }
+
+    set_castling(m_state.castling & castling_mask(move.from) & castling_mask(move.to));
+    set_en_passant(-1);
+
+    if (m_null_moves == 0) {
+        m_position.make_move(move);
+    }
+    m_state.side_to_move = chesscore::other_color(m_state.side_to_move);
+    m_state.key ^= zobrist_keys.black_to_move;
+
+    if (move.piece.type() == chesscore::PieceType::Pawn && std::abs(rank_of(move.to) - rank_of(move.from)) == 2 && en_passant_capturable(from_file)) {
+        set_en_passant(static_cast<std::int8_t>(from_file));
+    }
+}
+
+auto EnginePosition::unmake_move(const chesscore::Move &move) -> void {
+    if (m_null_moves == 0) {
+        m_position.unmake_move(move);
+    }
+    m_state = m_history.back();
+    m_history.pop_back();
+}
+
+auto EnginePosition::make_null_move() -> void {
+    m_history.push_back(m_state);
+    ++m_null_moves;
+    m_state.side_to_move = chesscore::other_color(m_state.side_to_move);
+    set_en_passant(-1);
+    m_state.key ^= zobrist_keys.black_to_move;
+    // Positions before the null move cannot be repeated in the search.
+    ++m_state.halfmove_clock;
+    m_state.reversible_plies = 0;
+}
+
+auto EnginePosition::unmake_null_move() -> void {
+    --m_null_moves;
+    m_state = m_history.back();
+    m_history.pop_back();
+}
+
+auto EnginePosition::is_repetition() const -> bool {
+    const auto reversible_plies = std::min<std::size_t>(m_state.reversible_plies, m_history.size());
+    // The same side is to move every other ply, and at least four plies are needed to repeat a position.
+    for (std::size_t distance = 4; distance <= reversible_plies; distance += 2) {
+        if (m_history[m_history.size() - distance].key == m_state.key) {
+            return true;
+        }
+    }
+    return false;
+}
+
+auto EnginePosition::is_draw() const -> bool {
+    if (is_repetition()) {
+        return true;
+    }
+    // A checkmate with the move that reaches the limit takes precedence.
+    return m_state.halfmove_clock >= fifty_move_plies && !(in_check() && !MoveGenerator{*this}.has_legal_moves());
+}
+
+auto EnginePosition::toggle_piece(chesscore::Piece piece, const chesscore::Square &square) -> void {
+    m_state.key ^= zobrist_keys.piece(piece, square);
+    if (piece.type() == chesscore::PieceType::Pawn) {
+        m_state.pawn_key ^= zobrist_keys.piece(piece, square);
+    }
+    const auto removed = (m_state.board.pieces(piece.color()) & square_bit(square.index())) != 0;
+    const auto count = static_cast<std::size_t>(std::popcount(m_state.board.pieces(piece.color(), piece.type())));
+    m_state.material_key ^= zobrist_keys.material_piece(piece, removed ? count - 1 : count);
+    if (m_piece_square_values != nullptr) {
+        if (removed) {
+            m_state.eval.remove(*m_piece_square_values, piece, square.index());
+        } else {
+            m_state.eval.add(*m_piece_square_values, piece, square.index());
+        }
+    }
+    m_state.board.toggle(piece, square.index());
+}
+
+auto EnginePosition::set_castling(std::uint8_t castling) -> void {
+    m_state.key ^= zobrist_keys.castling[m_state.castling] ^ zobrist_keys.castling[castling];
+    m_state.castling = castling;
+}
+
+auto EnginePosition::set_en_passant(std::int8_t file) -> void {
+    if (m_state.en_passant >= 0) {
+        m_state.key ^= zobrist_keys.en_passant[m_state.en_passant];
+    }
+    if (file >= 0) {
+        m_state.key ^= zobrist_keys.en_passant[file];
+    }
+    m_state.en_passant = file;
+}
+
+auto EnginePosition::en_passant_capturable(int file) const -> bool {
+    // Only include the en-passant target in the key, if a pawn of the side to move could capture.
+    const auto capturing_color = side_to_move();
+    const auto pawn_rank = capturing_color == chesscore::Color::White ? 4 : 3;
+    const auto pawns = m_state.board.pieces(capturing_color, chesscore::PieceType::Pawn);
+    for (const auto neighbour : {file - 1, file + 1}) {
+        if (neighbour >= 0 && neighbour < chesscore::File::count && (pawns & square_bit(chesscore::Square{neighbour, pawn_rank}.index())) != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+auto EnginePosition::compute_evaluation_terms(const BoardBitboards &board) const -> EvalAccumulator {
+    EvalAccumulator terms{};
+    if (m_piece_square_values == nullptr) {
+        return terms;
+    }
+    for (const auto color : {chesscore::Color::White, chesscore::Color::Black}) {
+        for (const auto type : chesscore::all_piece_types) {
+            const chesscore::Piece piece{type, color};
+            for (auto pieces = board.pieces(color, type); pieces != 0; pieces &= pieces - 1) {
+                terms.add(*m_piece_square_values, piece, lowest_square(pieces));
+            }
+        }
+    }
+    return terms;
+}
+
+} // namespace chessengine
@@ -0,0 +1,25 @@
+/* ************************************************************************** *
+ * Chess Engine Maat                                                          *
+ * Chess playing engine                                                       *
+ * ************************************************************************** */
+
+#include "chessengine/eval_accumulator.h"
+
+namespace chessengine {
+
+PieceSquareValues::PieceSquareValues(const EvaluatorConfig &config) {
+    for (const auto color : {chesscore::Color::White, chesscore::Color::Black}) {
+        for (const auto type : chesscore::all_piece_types) {
+            const chesscore::Piece piece{type, color};
+            m_material[piece_index(piece)] = config.piece_value(type);
+            chesscore::Square square{chesscore::Square::A1};
+            for (int i = 0; i < chesscore::Square::count; ++i) {
+                m_middlegame[piece_index(piece)][square.index()] = config.piece_on_square_value(piece, square);
+                m_endgame[piece_index(piece)][square.index()] = config.piece_on_square_endgame_value(piece, square);
+                square += 1;
+            }
+        }
+    }
+}
+
+} // namespace chessengine
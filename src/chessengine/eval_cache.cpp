@@ -0,0 +1,31 @@
+/* ************************************************************************** *
+ * Chess Engine Maat                                                          *
+ * Chess playing engine                                                       *
+ * ************************************************************************** */
+
+#include "chessengine/eval_cache.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace chessengine {
+
+auto EvalCache::resize(std::size_t size_mb) -> void {
+    constexpr std::size_t bytes_per_mb{1024 * 1024};
+    m_size_mb = size_mb;
+    if (size_mb == 0) {
+        m_entries.reset();
+        m_entry_count = 0;
+        m_index_mask = 0;
+        return;
+    }
+    m_entry_count = std::bit_floor(std::max<std::size_t>(size_mb * bytes_per_mb / sizeof(std::uint64_t), 1));
+    m_entries = std::make_unique<std::uint64_t[]>(m_entry_count);
+    m_index_mask = m_entry_count - 1;
+}
+
+auto EvalCache::clear() -> void {
+    std::fill_n(m_entries.get(), m_entry_count, std::uint64_t{0});
+}
+
+} // namespace chessengine
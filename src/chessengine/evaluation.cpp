@@ -5,20 +5,264 @@
 
 #include "chessengine/evaluation.h"
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdlib>
+
 namespace chessengine {
 
+namespace {
+
+/**
+ * \brief The least valuable piece in a set of squares.
+ *
+ * \param board The pieces of the position.
+ * \param candidates The squares to choose from.
+ * \return Square index and type of the piece.
+ */
+auto least_valuable_piece(const BoardBitboards &board, Bitboard candidates) -> std::pair<std::size_t, chesscore::PieceType> {
+    for (const auto type : chesscore::all_piece_types) {
+        const auto pieces = candidates & board.pieces(type);
+        if (pieces != 0) {
+            return {lowest_square(pieces), type};
+        }
+    }
+    return {lowest_square(candidates), chesscore::PieceType::King};
+}
+
+auto is_last_rank(std::size_t square) -> bool {
+    return square < 8 || square >= 56;
+}
+
+constexpr Bitboard file_a_squares{0x0101010101010101ULL};
+constexpr Bitboard rank_1_squares{0xFFULL};
+
+auto file_squares(std::size_t file) -> Bitboard {
+    return file_a_squares << file;
+}
+
+auto adjacent_file_squares(std::size_t file) -> Bitboard {
+    return (file > 0 ? file_squares(file - 1) : Bitboard{0}) | (file < 7 ? file_squares(file + 1) : Bitboard{0});
+}
+
+auto rank_squares(int rank) -> Bitboard {
+    return rank >= 0 && rank < 8 ? rank_1_squares << (rank * 8) : Bitboard{0};
+}
+
+/**
+ * \brief The squares on the ranks in front of a square.
+ *
+ * \param color The player, whose direction is forward.
+ * \param square Index of the square.
+ * \return All squares on the ranks between the square and the opponent's first rank.
+ */
+auto squares_in_front(chesscore::Color color, std::size_t square) -> Bitboard {
+    const auto rank = square / 8;
+    if (color == chesscore::Color::White) {
+        return rank < 7 ? ~Bitboard{0} << ((rank + 1) * 8) : Bitboard{0};
+    }
+    return (Bitboard{1} << (rank * 8)) - 1;
+}
+
+auto relative_rank(chesscore::Color color, std::size_t square) -> std::size_t {
+    return color == chesscore::Color::White ? square / 8 : 7 - square / 8;
+}
+
+auto add(TaperedScore &score, const TaperedScore &term) -> void {
+    score.middlegame += term.middlegame;
+    score.endgame += term.endgame;
+}
+
+/**
+ * \brief A score from white's perspective seen from the perspective of a player.
+ *
+ * \param score The score for white.
+ * \param color The player.
+ * \return The score for the player.
+ */
+auto perspective(const TaperedScore &score, chesscore::Color color) -> TaperedScore {
+    return color == chesscore::Color::White ? score : TaperedScore{-score.middlegame, -score.endgame};
+}
+
+/**
+ * \brief Evaluation of an endgame against a lone king.
+ *
+ * The strong side has enough material to checkmate. It gains by driving the
+ * lone king to the edge of the board and by approaching it with its own king.
+ * \param board The pieces of the position.
+ * \param strong_side The side with the material.
+ * \return Score for the strong side.
+ */
+auto evaluate_mating_drive(const BoardBitboards &board, chesscore::Color strong_side) -> Score {
+    constexpr int edge_weight{20};
+    constexpr int proximity_weight{10};
+    const auto strong_king = static_cast<int>(lowest_square(board.pieces(strong_side, chesscore::PieceType::King)));
+    const auto weak_king = static_cast<int>(lowest_square(board.pieces(chesscore::other_color(strong_side), chesscore::PieceType::King)));
+    const auto weak_file = weak_king % 8;
+    const auto weak_rank = weak_king / 8;
+    const auto edge_distance = std::min(weak_file, 7 - weak_file) + std::min(weak_rank, 7 - weak_rank);
+    const auto king_distance = std::max(std::abs(strong_king % 8 - weak_file), std::abs(strong_king / 8 - weak_rank));
+    return Score{static_cast<Score::value_type>(edge_weight * (6 - edge_distance) + proximity_weight * (7 - king_distance))};
+}
+
+} // namespace
+
 auto Evaluator::evaluate(const chesscore::Position &position, chesscore::Color color) const -> Score {
-    if (is_mate(position)) {
-        return color == position.side_to_move() ? -Score::Mate : Score::Mate;
+    const auto check_state = position.check_state();
+    if (check_state == chesscore::CheckState::Checkmate || check_state == chesscore::CheckState::Stalemate) {
+        const auto score = terminal_score(check_state == chesscore::CheckState::Checkmate);
+        return color == position.side_to_move() ? score : -score;
     }
+    return static_evaluation(position, color);
+}
+
+auto Evaluator::static_evaluation(const chesscore::Position &position, chesscore::Color color) const -> Score {
     Score score{0};
     if (m_config.use_material_balance) {
         score += countup_material(position, color) - countup_material(position, chesscore::other_color(color));
     }
+    TaperedScore positional{};
     if (m_config.use_piece_square_tables) {
-        score += evaluate_pieces_on_squares(position, color);
+        const auto other = chesscore::other_color(color);
+        positional.middlegame += evaluate_pieces_on_squares(position, color) - evaluate_pieces_on_squares(position, other);
+        positional.endgame += evaluate_pieces_on_endgame_squares(position, color) - evaluate_pieces_on_endgame_squares(position, other);
+    }
+    const BoardBitboards board{position};
+    return combine_terms(board, score, positional, m_config.use_pawn_structure ? pawn_entry(board) : PawnEntry{}, material_entry(board), color);
+}
+
+auto Evaluator::static_evaluation(const EnginePosition &position, const PawnEntry &pawns, const MaterialEntry &material, chesscore::Color color) const -> Score {
+    const auto &terms = position.evaluation_terms();
+    const auto us = color_index(color);
+    const auto them = color_index(chesscore::other_color(color));
+    Score score{0};
+    if (m_config.use_material_balance) {
+        score += terms.material[us] - terms.material[them];
+    }
+    TaperedScore positional{};
+    if (m_config.use_piece_square_tables) {
+        positional.middlegame += terms.middlegame[us] - terms.middlegame[them];
+        positional.endgame += terms.endgame[us] - terms.endgame[them];
+    }
+    return combine_terms(position.board(), score, positional, pawns, material, color);
+}
+
+auto Evaluator::combine_terms(const BoardBitboards &board, Score material_balance, TaperedScore positional, const PawnEntry &pawns, const MaterialEntry &material, chesscore::Color color) const
+    -> Score {
+    if (m_config.use_endgame_knowledge) {
+        if (material.draw) {
+            return Score{0};
+        }
+        if (material.endgame != nullptr) {
+            const auto score = material.endgame(board, material.strong_side);
+            return material_balance + (color == material.strong_side ? score : -score);
+        }
+    }
+    if (m_config.use_pawn_structure) {
+        add(positional, perspective(TaperedScore{pawns.middlegame + pawns.king_shelter, pawns.endgame}, color));
+    }
+    if (m_config.use_material_imbalance) {
+        add(positional, perspective(material.imbalance, color));
+    }
+    const auto score = material_balance + EvaluatorConfig::tapered(positional.middlegame, positional.endgame, material.phase);
+    if (!m_config.use_endgame_knowledge) {
+        return score;
+    }
+    // Scale the advantage down, if the leading side will hardly be able to win.
+    const auto leading_side = score > Score{0} ? color : chesscore::other_color(color);
+    const auto scale = material.scale[color_index(leading_side)];
+    return Score{static_cast<Score::value_type>(score.value * scale / MaterialEntry::full_scale)};
+}
+
+auto Evaluator::pawn_entry(const BoardBitboards &board) const -> PawnEntry {
+    PawnEntry entry{};
+    evaluate_pawn_structure(board, entry);
+    evaluate_king_shelter(board, entry);
+    return entry;
+}
+
+auto Evaluator::update_pawn_entry(const BoardBitboards &board, HashKey key, PawnEntry &entry) const -> bool {
+    const auto hit = entry.key == key;
+    if (!hit) {
+        // The king shelter of the old entry belongs to other pawns, even if the kings stand on the same squares.
+        entry = PawnEntry{};
+        evaluate_pawn_structure(board, entry);
+        entry.key = key;
+    }
+    evaluate_king_shelter(board, entry);
+    return hit;
+}
+
+auto Evaluator::evaluate_pawn_structure(const BoardBitboards &board, PawnEntry &entry) const -> void {
+    entry.middlegame = Score{0};
+    entry.endgame = Score{0};
+    for (const auto color : {chesscore::Color::White, chesscore::Color::Black}) {
+        const auto own_pawns = board.pieces(color, chesscore::PieceType::Pawn);
+        const auto enemy_pawns = board.pieces(chesscore::other_color(color), chesscore::PieceType::Pawn);
+        TaperedScore score{};
+        Bitboard passed_pawns{0};
+        for (auto pawns = own_pawns; pawns != 0; pawns &= pawns - 1) {
+            const auto square = lowest_square(pawns);
+            const auto file = square % 8;
+            const auto in_front = squares_in_front(color, square);
+            const auto neighbours = own_pawns & adjacent_file_squares(file);
+            if ((own_pawns & in_front & file_squares(file)) != 0) {
+                add(score, m_config.doubled_pawn);
+            } else if ((enemy_pawns & in_front & (file_squares(file) | adjacent_file_squares(file))) == 0) {
+                passed_pawns |= square_bit(square);
+                add(score, m_config.passed_pawn[relative_rank(color, square)]);
+            }
+            if (neighbours == 0) {
+                add(score, m_config.isolated_pawn);
+            } else if ((neighbours & ~in_front) == 0) {
+                // All neighbours have advanced, so the pawn cannot be defended, when an enemy pawn controls the square in front of it.
+                const auto stop_square = color == chesscore::Color::White ? square + 8 : square - 8;
+                if ((pawn_attacks(color, stop_square) & enemy_pawns) != 0) {
+                    add(score, m_config.backward_pawn);
+                }
+            }
+        }
+        entry.passed_pawns[color_index(color)] = passed_pawns;
+        if (color == chesscore::Color::White) {
+            entry.middlegame += score.middlegame;
+            entry.endgame += score.endgame;
+        } else {
+            entry.middlegame -= score.middlegame;
+            entry.endgame -= score.endgame;
+        }
+    }
+}
+
+auto Evaluator::evaluate_king_shelter(const BoardBitboards &board, PawnEntry &entry) const -> void {
+    std::array<std::uint8_t, 2> king_squares{PawnEntry::no_square, PawnEntry::no_square};
+    for (const auto color : {chesscore::Color::White, chesscore::Color::Black}) {
+        const auto king = board.pieces(color, chesscore::PieceType::King);
+        if (king != 0) {
+            king_squares[color_index(color)] = static_cast<std::uint8_t>(lowest_square(king));
+        }
+    }
+    if (king_squares == entry.king_squares) {
+        return;
+    }
+    entry.king_squares = king_squares;
+    entry.king_shelter = Score{0};
+    for (const auto color : {chesscore::Color::White, chesscore::Color::Black}) {
+        const std::size_t square = king_squares[color_index(color)];
+        if (square == PawnEntry::no_square) {
+            continue;
+        }
+        const auto rank = static_cast<int>(square / 8);
+        const auto forward = color == chesscore::Color::White ? 1 : -1;
+        const auto files = file_squares(square % 8) | adjacent_file_squares(square % 8);
+        const auto shelter = board.pieces(color, chesscore::PieceType::Pawn) & files & (rank_squares(rank + forward) | rank_squares(rank + 2 * forward));
+        const auto score = m_config.king_shelter_pawn * std::popcount(shelter);
+        if (color == chesscore::Color::White) {
+            entry.king_shelter += score;
+        } else {
+            entry.king_shelter -= score;
+        }
     }
-    return score;
 }
 
 auto Evaluator::evaluate(const chesscore::Move &move) const -> Score {
@@ -60,6 +304,84 @@ auto Evaluator::evaluate_pieces_on_squares(const chesscore::Position &position,
     return score;
 }
 
+auto Evaluator::evaluate_pieces_on_endgame_squares(const chesscore::Position &position, chesscore::Color color) const -> Score {
+    Score score{0};
+    chesscore::Square square{chesscore::Square::A1};
+    for (int i = 0; i < chesscore::Square::count; ++i) {
+        const auto piece = position.board().get_piece(square);
+        if (piece.has_value() && piece->color() == color) {
+            score += m_config.piece_on_square_endgame_value(piece.value(), square);
+        }
+        square += 1;
+    }
+    return score;
+}
+
+auto Evaluator::material_entry(const BoardBitboards &board) const -> MaterialEntry {
+    const auto count = [&board](chesscore::Color color, chesscore::PieceType type) -> int { return std::popcount(board.pieces(color, type)); };
+    const auto value = [this](chesscore::PieceType type) -> int { return m_config.piece_value(type).value; };
+    const std::array<chesscore::Color, 2> colors{chesscore::Color::White, chesscore::Color::Black};
+
+    MaterialEntry entry{};
+    int phase{0};
+    std::array<int, 2> non_pawn_material{0, 0};
+    for (const auto color : colors) {
+        for (const auto type : chesscore::all_piece_types) {
+            phase += m_config.phase_weight(type) * count(color, type);
+            if (type != chesscore::PieceType::Pawn && type != chesscore::PieceType::King) {
+                non_pawn_material[color_index(color)] += value(type) * count(color, type);
+            }
+        }
+
+        TaperedScore imbalance{};
+        if (count(color, chesscore::PieceType::Bishop) >= 2) {
+            add(imbalance, m_config.bishop_pair);
+        }
+        // Knights gain value with many pawns on the board, rooks with open lines.
+        const auto pawns_above_five = count(color, chesscore::PieceType::Pawn) - 5;
+        const auto pawn_adjustment = m_config.knight_pawn_adjustment * (count(color, chesscore::PieceType::Knight) * pawns_above_five) +
+                                     m_config.rook_pawn_adjustment * (count(color, chesscore::PieceType::Rook) * pawns_above_five);
+        add(imbalance, TaperedScore{pawn_adjustment, pawn_adjustment});
+        add(entry.imbalance, perspective(imbalance, color));
+    }
+    entry.phase = static_cast<std::uint8_t>(std::min(phase, EvaluatorConfig::max_game_phase));
+
+    const auto minor_value = std::max(value(chesscore::PieceType::Knight), value(chesscore::PieceType::Bishop));
+    for (const auto color : colors) {
+        const auto us = color_index(color);
+        const auto them = color_index(chesscore::other_color(color));
+        if (count(color, chesscore::PieceType::Pawn) == 0) {
+            const auto two_knights = count(color, chesscore::PieceType::Knight) == 2 && non_pawn_material[us] == 2 * value(chesscore::PieceType::Knight);
+            if (non_pawn_material[us] <= minor_value || two_knights) {
+                // A single minor piece or two knights cannot force a checkmate.
+                entry.scale[us] = 0;
+            } else if (non_pawn_material[us] - non_pawn_material[them] <= minor_value) {
+                entry.scale[us] = MaterialEntry::drawish_scale;
+            }
+        }
+        if (non_pawn_material[them] == 0 && count(chesscore::other_color(color), chesscore::PieceType::Pawn) == 0 &&
+            non_pawn_material[us] >= value(chesscore::PieceType::Rook)) {
+            entry.endgame = &evaluate_mating_drive;
+            entry.strong_side = color;
+        }
+    }
+
+    const auto pawns_rooks_queens = board.pieces(chesscore::PieceType::Pawn) | board.pieces(chesscore::PieceType::Rook) | board.pieces(chesscore::PieceType::Queen);
+    const auto minors = board.pieces(chesscore::PieceType::Knight) | board.pieces(chesscore::PieceType::Bishop);
+    entry.draw = pawns_rooks_queens == 0 && std::popcount(minors) <= 1;
+    return entry;
+}
+
+auto Evaluator::game_phase(const chesscore::Position &position) const -> int {
+    int phase{0};
+    for (const auto piece_type : chesscore::all_piece_types) {
+        for (const auto color : {chesscore::Color::White, chesscore::Color::Black}) {
+            phase += m_config.phase_weight(piece_type) * static_cast<int>(position.board().piece_count(chesscore::Piece{piece_type, color}));
+        }
+    }
+    return std::min(phase, EvaluatorConfig::max_game_phase);
+}
+
 auto Evaluator::get_capture_score(const chesscore::Move &move) const -> Score {
     if (move.is_capture()) {
         return m_config.piece_value(move.captured.value().type());
@@ -78,4 +400,68 @@ auto Evaluator::get_piece_movement_score(const chesscore::Move &move) const -> S
     return m_config.piece_on_square_value(move.piece, move.to) - m_config.piece_on_square_value(move.piece, move.from);
 }
 
+auto Evaluator::see(const BoardBitboards &board, const chesscore::Move &move) const -> Score {
+    const auto target = move.to.index();
+    const auto value = [this](chesscore::PieceType type) -> int { return m_config.piece_value(type).value; };
+
+    // gains[i] is the material balance for the side making capture i, if the exchange stops after it.
+    std::array<int, 32> gains{};
+    auto occupied = board.occupied() ^ square_bit(move.from.index());
+    if (move.is_capture()) {
+        gains[0] = value(move.captured->type());
+        if ((board.occupied() & square_bit(target)) == 0) {
+            // En passant: the captured pawn is not on the target square.
+            occupied ^= square_bit(move.from.index() / 8 * 8 + target % 8);
+        }
+    }
+    auto piece_on_target = move.piece.type();
+    if (move.is_pawn_promotion()) {
+        piece_on_target = move.promoted->type();
+        gains[0] += value(piece_on_target) - value(chesscore::PieceType::Pawn);
+    }
+
+    auto side = chesscore::other_color(move.piece.color());
+    std::size_t depth{0};
+    while (depth + 1 < gains.size()) {
+        const auto attackers = board.attackers_to(target, occupied);
+        const auto own_attackers = attackers & board.pieces(side);
+        if (own_attackers == 0) {
+            break;
+        }
+        const auto [square, type] = least_valuable_piece(board, own_attackers);
+        if (type == chesscore::PieceType::King && (board.attackers_to(target, occupied ^ square_bit(square)) & board.pieces(chesscore::other_color(side))) != 0) {
+            // The king must not capture a defended piece.
+            break;
+        }
+        ++depth;
+        gains[depth] = value(piece_on_target) - gains[depth - 1];
+        piece_on_target = type;
+        if (type == chesscore::PieceType::Pawn && is_last_rank(target)) {
+            piece_on_target = chesscore::PieceType::Queen;
+            gains[depth] += value(piece_on_target) - value(chesscore::PieceType::Pawn);
+        }
+        // Removing the capturing piece reveals sliding pieces behind it.
+        occupied ^= square_bit(square);
+        side = chesscore::other_color(side);
+    }
+    // Each side only continues the exchange, if that is better than stopping.
+    while (depth > 0) {
+        gains[depth - 1] = -std::max(-gains[depth - 1], gains[depth]);
+        --depth;
+    }
+    return Score{static_cast<Score::value_type>(gains[0])};
+}
+
+auto Evaluator::get_mvv_lva_score(const chesscore::Move &move) const -> Score {
+    constexpr int victim_factor{10};
+    Score score{0};
+    if (move.is_capture()) {
+        score += victim_factor * m_config.piece_value(move.captured.value().type()) - m_config.piece_value(move.piece.type());
+    }
+    if (move.is_pawn_promotion()) {
+        score += m_config.piece_value(move.promoted.value().type()) - m_config.piece_value(chesscore::PieceType::Pawn);
+    }
+    return score;
+}
+
 } // namespace chessengine
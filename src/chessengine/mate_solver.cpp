@@ -0,0 +1,235 @@
+/* ************************************************************************** *
+ * Chess Engine Maat                                                          *
+ * Chess playing engine                                                       *
+ * ************************************************************************** */
+
+#include "chessengine/mate_solver.h"
+#include "chessengine/logger.h"
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+
+namespace chessengine {
+
+namespace {
+
+/// Value of a proof or disproof number for a solved node. Sums of two values cannot overflow.
+constexpr std::uint32_t proof_infinity{std::numeric_limits<std::uint32_t>::max() / 2};
+
+/// Number of nodes between two checks of the search time.
+constexpr std::int64_t time_check_interval{1024};
+
+/// Mixes the number of remaining plies into the key of a position.
+constexpr HashKey remaining_plies_key{0x9E3779B97F4A7C15ULL};
+
+/**
+ * \brief Add two proof numbers.
+ *
+ * \param lhs First summand.
+ * \param rhs Second summand.
+ * \return The sum, limited to proof_infinity.
+ */
+auto proof_sum(std::uint32_t lhs, std::uint32_t rhs) -> std::uint32_t {
+    return std::min(lhs + rhs, proof_infinity);
+}
+
+/**
+ * \brief Check, if the attacker is to move.
+ *
+ * The attacker moves first and makes the last move of the mate, so it is the
+ * attacker's turn when an odd number of plies is left.
+ * \param remaining_plies Number of plies left for the mate.
+ * \return If the attacker is to move.
+ */
+auto is_attacker_node(int remaining_plies) -> bool {
+    return remaining_plies % 2 == 1;
+}
+
+} // namespace
+
+MateSolver::MateSolver(const std::atomic<bool> &stop_requested, std::size_t size_mb) : m_stop_requested{stop_requested} {
+    constexpr std::size_t bytes_per_mb{1024 * 1024};
+    m_table.resize(std::bit_floor(std::max<std::size_t>(std::max<std::size_t>(size_mb, 1) * bytes_per_mb / sizeof(Entry), 1)));
+}
+
+auto MateSolver::clear() -> void {
+    std::ranges::fill(m_table, Entry{});
+}
+
+auto MateSolver::solve(EnginePosition &position, int moves, const StopParameters &stop_params, std::chrono::steady_clock::time_point start) -> SearchStats {
+    m_position = &position;
+    m_stop_params = stop_params;
+    m_start = start;
+    m_nodes = 0;
+    m_stopped = false;
+
+    SearchStats search_stats{};
+    for (int mate_moves = 1; mate_moves <= moves && !m_stopped; ++mate_moves) {
+        const auto plies = 2 * mate_moves - 1;
+        const auto numbers = search_node(plies, ProofNumbers{.phi = proof_infinity, .delta = proof_infinity});
+        log_search_stream() << "Mate in " << mate_moves << ": phi = " << numbers.phi << ", delta = " << numbers.delta << ", " << m_nodes << " nodes";
+        search_stats.depth = Depth{static_cast<Depth::value_type>(plies)};
+        if (numbers.phi == 0) {
+            auto line = mating_line(plies);
+            if (!line.empty()) {
+                search_stats.best_move = EvaluatedMove{.move = line.front(), .score = Score::Mate - search_stats.depth, .pv = std::move(line)};
+            }
+            break;
+        }
+    }
+    search_stats.nodes = m_nodes;
+    search_stats.elapsed_time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - m_start);
+    m_position = nullptr;
+    return search_stats;
+}
+
+auto MateSolver::search_node(int remaining_plies, ProofNumbers thresholds) -> ProofNumbers {
+    ++m_nodes;
+    const auto key = node_key(remaining_plies);
+    if (const auto numbers = terminal_numbers(remaining_plies); numbers.has_value()) {
+        store(key, numbers.value());
+        return numbers.value();
+    }
+
+    const auto children = generate_children(remaining_plies);
+    ProofNumbers numbers{};
+    PackedMove best_move{};
+    while (true) {
+        // A node is won, if one child is lost for the opponent, and lost, if all children are won for the opponent.
+        numbers = ProofNumbers{.phi = proof_infinity, .delta = 0};
+        const Child *best_child{nullptr};
+        std::uint32_t best_child_phi{0};
+        std::uint32_t second_delta{proof_infinity};
+        for (const auto &child : children) {
+            const auto *entry = probe(child.key);
+            const auto child_numbers = entry != nullptr ? entry->numbers : ProofNumbers{};
+            numbers.delta = proof_sum(numbers.delta, child_numbers.phi);
+            if (child_numbers.delta < numbers.phi) {
+                second_delta = numbers.phi;
+                numbers.phi = child_numbers.delta;
+                best_child = &child;
+                best_child_phi = child_numbers.phi;
+            } else if (child_numbers.delta < second_delta) {
+                second_delta = child_numbers.delta;
+            }
+        }
+        if (best_child != nullptr) {
+            best_move = PackedMove{best_child->move};
+        } else if (!children.empty()) {
+            // All children are won for the opponent, any move continues the line.
+            best_move = PackedMove{children.front().move};
+        }
+        if (numbers.phi >= thresholds.phi || numbers.delta >= thresholds.delta || should_stop()) {
+            break;
+        }
+
+        // Search the child until it is no longer the most promising one or the node reaches its threshold.
+        const ProofNumbers child_thresholds{
+            .phi = thresholds.delta - numbers.delta + best_child_phi,
+            .delta = std::min(thresholds.phi, second_delta + 1),
+        };
+        MoveScope move_scope{*m_position, best_child->move};
+        search_node(remaining_plies - 1, child_thresholds);
+    }
+    store(key, numbers, best_move);
+    return numbers;
+}
+
+auto MateSolver::generate_children(int remaining_plies) -> std::vector<Child> {
+    const bool attacker = is_attacker_node(remaining_plies);
+    std::vector<Child> children;
+    std::vector<Child> quiet_children;
+    for (const auto &move : m_position->position().all_legal_moves()) {
+        MoveScope move_scope{*m_position, move};
+        const bool gives_check = m_position->position().check_state() != chesscore::CheckState::None;
+        if (attacker && !gives_check && remaining_plies == 1) {
+            continue;
+        }
+        const auto key = node_key(remaining_plies - 1);
+        if (probe(key) == nullptr) {
+            if (const auto numbers = terminal_numbers(remaining_plies - 1); numbers.has_value()) {
+                store(key, numbers.value());
+            }
+        }
+        if (attacker && !gives_check) {
+            quiet_children.push_back(Child{.move = move, .key = key});
+        } else {
+            children.push_back(Child{.move = move, .key = key});
+        }
+    }
+    children.insert(children.end(), quiet_children.begin(), quiet_children.end());
+    return children;
+}
+
+auto MateSolver::terminal_numbers(int remaining_plies) const -> std::optional<ProofNumbers> {
+    constexpr ProofNumbers won{.phi = 0, .delta = proof_infinity};
+    constexpr ProofNumbers lost{.phi = proof_infinity, .delta = 0};
+    const auto check_state = m_position->position().check_state();
+    if (check_state == chesscore::CheckState::Checkmate) {
+        return lost;
+    }
+    if (check_state == chesscore::CheckState::Stalemate) {
+        return is_attacker_node(remaining_plies) ? lost : won;
+    }
+    if (remaining_plies == 0) {
+        // The defender survived all moves of the attacker
+        return won;
+    }
+    return std::nullopt;
+}
+
+auto MateSolver::mating_line(int remaining_plies) -> chesscore::MoveList {
+    chesscore::MoveList line;
+    for (int plies = remaining_plies; plies > 0; --plies) {
+        const auto *entry = probe(node_key(plies));
+        if (entry == nullptr || entry->best_move.empty()) {
+            break;
+        }
+        const auto moves = m_position->position().all_legal_moves();
+        const auto move = std::ranges::find_if(moves, [entry](const chesscore::Move &legal_move) -> bool { return entry->best_move.matches(legal_move); });
+        if (move == moves.end()) {
+            break;
+        }
+        line.push_back(*move);
+        m_position->make_move(*move);
+    }
+    for (auto move = line.rbegin(); move != line.rend(); ++move) {
+        m_position->unmake_move(*move);
+    }
+    return line;
+}
+
+auto MateSolver::should_stop() -> bool {
+    if (m_stopped) {
+        return true;
+    }
+    const auto max_search_time = m_stop_params.max_search_time;
+    if (m_stop_requested.load(std::memory_order_relaxed)) {
+        log_search("STOPPING. Mate search cancelled");
+        m_stopped = true;
+    } else if (m_stop_params.max_search_nodes > 0 && m_nodes >= m_stop_params.max_search_nodes) {
+        log_search("STOPPING. Max nodes reached");
+        m_stopped = true;
+    } else if (m_nodes % time_check_interval == 0 && max_search_time.count() > 0 && max_search_time != std::chrono::milliseconds::max() &&
+               std::chrono::steady_clock::now() - m_start >= max_search_time) {
+        log_search("STOPPING. Max search time exceeded");
+        m_stopped = true;
+    }
+    return m_stopped;
+}
+
+auto MateSolver::node_key(int remaining_plies) const -> HashKey {
+    return m_position->key() ^ (static_cast<HashKey>(remaining_plies) * remaining_plies_key);
+}
+
+auto MateSolver::probe(HashKey key) const -> const Entry * {
+    const auto &entry = m_table[key & (m_table.size() - 1)];
+    return entry.key == key ? &entry : nullptr;
+}
+
+auto MateSolver::store(HashKey key, ProofNumbers numbers, PackedMove best_move) -> void {
+    m_table[key & (m_table.size() - 1)] = Entry{.key = key, .numbers = numbers, .best_move = best_move};
+}
+
+} // namespace chessengine
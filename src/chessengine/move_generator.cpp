@@ -0,0 +1,314 @@
+/* ************************************************************************** *
+ * Chess Engine Maat                                                          *
+ * Chess playing engine                                                       *
+ * ************************************************************************** */
+
+#include "chessengine/move_generator.h"
+
+#include <algorithm>
+#include <array>
+
+namespace chessengine {
+
+namespace {
+
+constexpr Bitboard last_ranks{0xFF000000000000FFULL};                                          ///< Squares, where pawns promote.
+constexpr std::array<Bitboard, 2> double_push_ranks{0x0000000000FF0000ULL, 0x0000FF0000000000ULL}; ///< Squares after the first step of a double push.
+constexpr std::array<chesscore::PieceType, 4> promotion_types{
+    chesscore::PieceType::Queen, chesscore::PieceType::Knight, chesscore::PieceType::Rook, chesscore::PieceType::Bishop
+};
+
+auto to_square(std::size_t index) -> chesscore::Square {
+    return chesscore::Square{static_cast<int>(index % 8), static_cast<int>(index / 8)};
+}
+
+/**
+ * \brief The square in front of a pawn.
+ *
+ * \param color Color of the pawn.
+ * \param square Index of the pawn's square.
+ * \return Index of the square one step forward.
+ */
+auto forward(chesscore::Color color, std::size_t square) -> std::size_t {
+    return color == chesscore::Color::White ? square + 8 : square - 8;
+}
+
+/**
+ * \brief The square behind a pawn.
+ *
+ * \param color Color of the pawn.
+ * \param square Index of the pawn's square.
+ * \return Index of the square one step backward.
+ */
+auto backward(chesscore::Color color, std::size_t square) -> std::size_t {
+    return color == chesscore::Color::White ? square - 8 : square + 8;
+}
+
+/**
+ * \brief Squares a set of pawns moves to with one step forward.
+ *
+ * \param color Color of the pawns.
+ * \param pawns The pawns.
+ * \return The squares in front of the pawns.
+ */
+auto push(chesscore::Color color, Bitboard pawns) -> Bitboard {
+    return color == chesscore::Color::White ? pawns << 8 : pawns >> 8;
+}
+
+/**
+ * \brief Squares of castling for one side.
+ */
+struct CastlingSquares {
+    std::uint8_t right; ///< The castling right.
+    std::size_t king;   ///< Start square of the king.
+    std::size_t target; ///< Target square of the king.
+    std::size_t rook;   ///< Start square of the rook.
+    Bitboard empty;     ///< Squares between king and rook, that have to be empty.
+    Bitboard safe;      ///< Squares the king passes, that must not be attacked.
+};
+
+constexpr std::array<std::array<CastlingSquares, 2>, 2> castling_squares{{
+    {{
+        {.right = EnginePosition::white_kingside, .king = 4, .target = 6, .rook = 7, .empty = 0x60ULL, .safe = 0x60ULL},
+        {.right = EnginePosition::white_queenside, .king = 4, .target = 2, .rook = 0, .empty = 0x0EULL, .safe = 0x0CULL},
+    }},
+    {{
+        {.right = EnginePosition::black_kingside, .king = 60, .target = 62, .rook = 63, .empty = 0x6000000000000000ULL, .safe = 0x6000000000000000ULL},
+        {.right = EnginePosition::black_queenside, .king = 60, .target = 58, .rook = 56, .empty = 0x0E00000000000000ULL, .safe = 0x0C00000000000000ULL},
+    }},
+}};
+
+} // namespace
+
+MoveGenerator::MoveGenerator(const EnginePosition &position)
+    : MoveGenerator{position.board(), position.side_to_move(), position.castling_rights(), position.en_passant_file()} {}
+
+MoveGenerator::MoveGenerator(const BoardBitboards &board, chesscore::Color side_to_move, std::uint8_t castling_rights, int en_passant_file)
+    : m_board{board}, m_us{side_to_move}, m_them{chesscore::other_color(side_to_move)}, m_castling{castling_rights}, m_en_passant{en_passant_file} {
+    const auto king = m_board.pieces(m_us, chesscore::PieceType::King);
+    if (king == 0) {
+        return;
+    }
+    m_king = lowest_square(king);
+    const auto occupied = m_board.occupied();
+    m_checkers = m_board.attackers_to(m_king, occupied) & m_board.pieces(m_them);
+
+    // A piece is pinned, if it is the only piece between its king and an enemy slider on the same line.
+    const auto queens = m_board.pieces(m_them, chesscore::PieceType::Queen);
+    const auto snipers = (rook_attacks(m_king, 0) & (m_board.pieces(m_them, chesscore::PieceType::Rook) | queens)) |
+                         (bishop_attacks(m_king, 0) & (m_board.pieces(m_them, chesscore::PieceType::Bishop) | queens));
+    for (auto remaining = snipers; remaining != 0; remaining &= remaining - 1) {
+        const auto blockers = between_squares(m_king, lowest_square(remaining)) & occupied;
+        if (std::has_single_bit(blockers) && (blockers & m_board.pieces(m_us)) != 0) {
+            m_pinned |= blockers;
+        }
+    }
+
+    if (std::has_single_bit(m_checkers)) {
+        m_evasion_targets = m_checkers | between_squares(m_king, lowest_square(m_checkers));
+    } else if (m_checkers != 0) {
+        m_evasion_targets = 0;
+    }
+}
+
+auto MoveGenerator::generate_captures(GeneratedMoves &moves) const -> void {
+    const auto targets = m_board.pieces(m_them);
+    generate_pawn_moves(moves, targets, ~m_board.occupied(), true);
+    generate_piece_moves(moves, targets);
+    generate_king_moves(moves, targets);
+}
+
+auto MoveGenerator::generate_quiets(GeneratedMoves &moves) const -> void {
+    const auto empty = ~m_board.occupied();
+    generate_pawn_moves(moves, 0, empty, false);
+    generate_piece_moves(moves, empty);
+    generate_king_moves(moves, empty);
+    if (!in_check()) {
+        generate_castling(moves);
+    }
+}
+
+auto MoveGenerator::generate_evasions(GeneratedMoves &moves) const -> void {
+    generate_king_moves(moves, ~m_board.pieces(m_us));
+    if (m_evasion_targets == 0) {
+        // In double check, only the king can move.
+        return;
+    }
+    const auto blocks = m_evasion_targets & ~m_checkers;
+    generate_pawn_moves(moves, m_checkers, blocks, true);
+    generate_pawn_moves(moves, 0, blocks, false);
+    generate_piece_moves(moves, m_evasion_targets);
+}
+
+auto MoveGenerator::generate_moves(GeneratedMoves &moves) const -> void {
+    if (in_check()) {
+        generate_evasions(moves);
+    } else {
+        generate_captures(moves);
+        generate_quiets(moves);
+    }
+}
+
+auto MoveGenerator::is_legal(const chesscore::Move &move) const -> bool {
+    const auto from = move.from.index();
+    const auto to = move.to.index();
+    const auto occupied = m_board.occupied();
+    if (move.piece.type() == chesscore::PieceType::King) {
+        if ((king_attacks(from) & square_bit(to)) == 0) {
+            // Castling, the squares the king passes were checked by the generator.
+            return true;
+        }
+        // Without the king, sliders attack through its current square.
+        return (m_board.attackers_to(to, occupied ^ square_bit(from)) & m_board.pieces(m_them)) == 0;
+    }
+    if (move.is_capture() && (occupied & square_bit(to)) == 0) {
+        // En passant removes two pieces from a line, which is not covered by the pins.
+        const auto captured = backward(m_us, to);
+        const auto after = (occupied ^ square_bit(from) ^ square_bit(captured)) | square_bit(to);
+        return (m_board.attackers_to(m_king, after) & m_board.pieces(m_them)) == 0;
+    }
+    if ((square_bit(to) & m_evasion_targets) == 0) {
+        return false;
+    }
+    return (m_pinned & square_bit(from)) == 0 || (line_through(m_king, from) & square_bit(to)) != 0;
+}
+
+auto MoveGenerator::generate_legal_moves(GeneratedMoves &moves) const -> void {
+    GeneratedMoves pseudo_legal_moves;
+    generate_moves(pseudo_legal_moves);
+    for (const auto &move : pseudo_legal_moves) {
+        if (is_legal(move)) {
+            moves.push_back(move);
+        }
+    }
+}
+
+auto MoveGenerator::has_legal_moves() const -> bool {
+    const auto any_legal = [this](const GeneratedMoves &moves) -> bool {
+        return std::ranges::any_of(moves, [this](const chesscore::Move &move) -> bool { return is_legal(move); });
+    };
+    // The king usually has a legal move, so try the king moves first. Castling is never the only legal move.
+    GeneratedMoves moves;
+    generate_king_moves(moves, ~m_board.pieces(m_us));
+    if (any_legal(moves)) {
+        return true;
+    }
+    moves.clear();
+    const auto empty = ~m_board.occupied() & m_evasion_targets;
+    generate_pawn_moves(moves, m_board.pieces(m_them) & m_evasion_targets, empty, true);
+    generate_pawn_moves(moves, 0, empty, false);
+    generate_piece_moves(moves, m_evasion_targets);
+    return any_legal(moves);
+}
+
+auto MoveGenerator::generate_pawn_moves(GeneratedMoves &moves, Bitboard captures, Bitboard pushes, bool promotions) const -> void {
+    const auto pawns = m_board.pieces(m_us, chesscore::PieceType::Pawn);
+    const auto empty = ~m_board.occupied();
+    if (!promotions) {
+        const auto single_pushes = push(m_us, pawns) & empty & ~last_ranks;
+        const auto double_pushes = push(m_us, single_pushes & double_push_ranks[color_index(m_us)]) & empty & pushes;
+        for (auto targets = single_pushes & pushes; targets != 0; targets &= targets - 1) {
+            const auto to = lowest_square(targets);
+            add_move(moves, backward(m_us, to), to, chesscore::PieceType::Pawn);
+        }
+        for (auto targets = double_pushes; targets != 0; targets &= targets - 1) {
+            const auto to = lowest_square(targets);
+            add_move(moves, backward(m_us, backward(m_us, to)), to, chesscore::PieceType::Pawn);
+        }
+        return;
+    }
+
+    for (auto remaining = pawns; remaining != 0; remaining &= remaining - 1) {
+        const auto from = lowest_square(remaining);
+        for (auto targets = pawn_attacks(m_us, from) & captures; targets != 0; targets &= targets - 1) {
+            const auto to = lowest_square(targets);
+            if ((square_bit(to) & last_ranks) != 0) {
+                add_promotions(moves, from, to);
+            } else {
+                add_move(moves, from, to, chesscore::PieceType::Pawn);
+            }
+        }
+        const auto to = forward(m_us, from);
+        if ((square_bit(to) & last_ranks & empty & pushes) != 0) {
+            add_promotions(moves, from, to);
+        }
+    }
+
+    if (m_en_passant >= 0) {
+        const auto target = static_cast<std::size_t>(m_en_passant) + (m_us == chesscore::Color::White ? 40 : 16);
+        // The en-passant capture resolves a check, if it captures the checking pawn or blocks on the target square.
+        if ((square_bit(backward(m_us, target)) & captures) != 0 || (square_bit(target) & pushes) != 0) {
+            for (auto attackers = pawn_attacks(m_them, target) & pawns; attackers != 0; attackers &= attackers - 1) {
+                chesscore::Move move{.from = to_square(lowest_square(attackers)), .to = to_square(target), .piece = chesscore::Piece{chesscore::PieceType::Pawn, m_us}};
+                move.captured = chesscore::Piece{chesscore::PieceType::Pawn, m_them};
+                moves.push_back(move);
+            }
+        }
+    }
+}
+
+auto MoveGenerator::generate_piece_moves(GeneratedMoves &moves, Bitboard targets) const -> void {
+    const auto occupied = m_board.occupied();
+    const auto own_pieces = m_board.pieces(m_us);
+    for (const auto type : {chesscore::PieceType::Knight, chesscore::PieceType::Bishop, chesscore::PieceType::Rook, chesscore::PieceType::Queen}) {
+        for (auto pieces = m_board.pieces(m_us, type); pieces != 0; pieces &= pieces - 1) {
+            const auto from = lowest_square(pieces);
+            Bitboard attacks{0};
+            if (type == chesscore::PieceType::Knight) {
+                attacks = knight_attacks(from);
+            }
+            if (type == chesscore::PieceType::Bishop || type == chesscore::PieceType::Queen) {
+                attacks |= bishop_attacks(from, occupied);
+            }
+            if (type == chesscore::PieceType::Rook || type == chesscore::PieceType::Queen) {
+                attacks |= rook_attacks(from, occupied);
+            }
+            for (auto remaining = attacks & targets & ~own_pieces; remaining != 0; remaining &= remaining - 1) {
+                add_move(moves, from, lowest_square(remaining), type);
+            }
+        }
+    }
+}
+
+auto MoveGenerator::generate_king_moves(GeneratedMoves &moves, Bitboard targets) const -> void {
+    if (m_board.pieces(m_us, chesscore::PieceType::King) == 0) {
+        return;
+    }
+    for (auto remaining = king_attacks(m_king) & targets & ~m_board.pieces(m_us); remaining != 0; remaining &= remaining - 1) {
+        add_move(moves, m_king, lowest_square(remaining), chesscore::PieceType::King);
+    }
+}
+
+auto MoveGenerator::generate_castling(GeneratedMoves &moves) const -> void {
+    const auto occupied = m_board.occupied();
+    const auto rooks = m_board.pieces(m_us, chesscore::PieceType::Rook);
+    for (const auto &castling : castling_squares[color_index(m_us)]) {
+        if ((m_castling & castling.right) == 0 || m_king != castling.king || (rooks & square_bit(castling.rook)) == 0 || (occupied & castling.empty) != 0) {
+            continue;
+        }
+        bool safe{true};
+        for (auto squares = castling.safe; squares != 0 && safe; squares &= squares - 1) {
+            safe = (m_board.attackers_to(lowest_square(squares), occupied) & m_board.pieces(m_them)) == 0;
+        }
+        if (safe) {
+            add_move(moves, castling.king, castling.target, chesscore::PieceType::King);
+        }
+    }
+}
+
+auto MoveGenerator::add_move(GeneratedMoves &moves, std::size_t from, std::size_t to, chesscore::PieceType type) const -> void {
+    chesscore::Move move{.from = to_square(from), .to = to_square(to), .piece = chesscore::Piece{type, m_us}};
+    move.captured = m_board.piece_on(to);
+    moves.push_back(move);
+}
+
+auto MoveGenerator::add_promotions(GeneratedMoves &moves, std::size_t from, std::size_t to) const -> void {
+    for (const auto type : promotion_types) {
+        chesscore::Move move{.from = to_square(from), .to = to_square(to), .piece = chesscore::Piece{chesscore::PieceType::Pawn, m_us}};
+        move.captured = m_board.piece_on(to);
+        move.promoted = chesscore::Piece{type, m_us};
+        moves.push_back(move);
+    }
+}
+
+} // namespace chessengine
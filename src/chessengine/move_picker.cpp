@@ -0,0 +1,72 @@
+/* ************************************************************************** *
+ * Chess Engine Maat                                                          *
+ * Chess playing engine                                                       *
+ * ************************************************************************** */
+
+#include "chessengine/move_picker.h"
+
+#include <algorithm>
+
+namespace chessengine {
+
+MovePicker::MovePicker(MoveBuffer &buffer, const MoveGenerator &generator, const Evaluator &evaluator, PackedMove hash_move, const MoveOrderingHints &hints, bool use_ordering)
+    : m_moves{buffer}, m_generator{generator}, m_use_ordering{use_ordering} {
+    constexpr std::int32_t killer_score{2};
+    GeneratedMoves moves;
+    generator.generate_moves(moves);
+    const auto &board = generator.board();
+    m_moves.clear();
+    for (const auto &move : moves) {
+        if (!m_use_ordering) {
+            m_moves.push_back({.move = move, .stage = Stage::Quiets, .score = 0});
+        } else if (hash_move.matches(move)) {
+            m_moves.push_back({.move = move, .stage = Stage::HashMove, .score = 0});
+        } else if (move.is_capture()) {
+            const auto stage = evaluator.see(board, move) >= Score{0} ? Stage::GoodCaptures : Stage::LosingCaptures;
+            m_moves.push_back({.move = move, .stage = stage, .score = evaluator.get_mvv_lva_score(move).value});
+        } else if (move.is_pawn_promotion()) {
+            m_moves.push_back({.move = move, .stage = Stage::Promotions, .score = evaluator.get_mvv_lva_score(move).value});
+        } else if (const auto killer = std::ranges::find_if(hints.killers, [&move](PackedMove killer) -> bool { return killer.matches(move); }); killer != hints.killers.end()) {
+            // The first killer is the most recent one
+            m_moves.push_back({.move = move, .stage = Stage::Killers, .score = killer_score - static_cast<std::int32_t>(killer - hints.killers.begin())});
+        } else if (hints.countermove.matches(move)) {
+            m_moves.push_back({.move = move, .stage = Stage::Killers, .score = 0});
+        } else {
+            const auto history = hints.history != nullptr ? hints.history->value(generator.side_to_move(), move) : 0;
+            m_moves.push_back({.move = move, .stage = Stage::Quiets, .score = history + evaluator.evaluate(move).value});
+        }
+    }
+}
+
+auto MovePicker::captures(MoveBuffer &buffer, const MoveGenerator &generator, const Evaluator &evaluator) -> MovePicker {
+    MovePicker picker{buffer, generator};
+    GeneratedMoves moves;
+    generator.generate_captures(moves);
+    for (const auto &move : moves) {
+        const auto stage = evaluator.see(generator.board(), move) >= Score{0} ? Stage::GoodCaptures : Stage::LosingCaptures;
+        picker.m_moves.push_back({.move = move, .stage = stage, .score = evaluator.get_mvv_lva_score(move).value});
+    }
+    return picker;
+}
+
+auto MovePicker::next() -> std::optional<chesscore::Move> {
+    while (m_current < m_moves.size()) {
+        if (m_use_ordering) {
+            auto best = m_moves.begin() + static_cast<std::ptrdiff_t>(m_current);
+            for (auto it = std::next(best); it != m_moves.end(); ++it) {
+                if (it->before(*best)) {
+                    best = it;
+                }
+            }
+            std::iter_swap(m_moves.begin() + static_cast<std::ptrdiff_t>(m_current), best);
+        }
+        const auto &selected = m_moves[m_current++];
+        if (m_generator.is_legal(selected.move)) {
+            m_stage = selected.stage;
+            return selected.move;
+        }
+    }
+    return std::nullopt;
+}
+
+} // namespace chessengine
@@ -0,0 +1,21 @@
+/* ************************************************************************** *
+ * Chess Engine Maat                                                          *
+ * Chess playing engine                                                       *
+ * ************************************************************************** */
+
+#include "chessengine/pawn_hash_table.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace chessengine {
+
+PawnHashTable::PawnHashTable(std::size_t entry_count) : m_entry_count{std::bit_floor(std::max<std::size_t>(entry_count, 1))} {
+    m_entries = std::make_unique<PawnEntry[]>(m_entry_count);
+}
+
+auto PawnHashTable::clear() -> void {
+    std::fill_n(m_entries.get(), m_entry_count, PawnEntry{});
+}
+
+} // namespace chessengine
@@ -0,0 +1,141 @@
+/* ************************************************************************** *
+ * Chess Engine Maat                                                          *
+ * Chess playing engine                                                       *
+ * ************************************************************************** */
+
+#include "chessengine/perft.h"
+#include "chessengine/move_generator.h"
+
+#include <chessuci/move.h>
+
+#include <algorithm>
+#include <bit>
+#include <format>
+#include <thread>
+
+namespace chessengine {
+
+namespace {
+
+/// Mixes the remaining depth into the key of a position.
+constexpr HashKey remaining_depth_key{0x9E3779B97F4A7C15ULL};
+
+auto node_key(const EnginePosition &position, int depth) -> HashKey {
+    return position.key() ^ (static_cast<HashKey>(depth) * remaining_depth_key);
+}
+
+} // namespace
+
+Perft::Perft(const PerftConfig &config) : m_config{config} {
+    if (m_config.hash_size_mb > 0) {
+        constexpr std::size_t bytes_per_mb{1024 * 1024};
+        m_cache_size = std::bit_floor(std::max<std::size_t>(m_config.hash_size_mb * bytes_per_mb / sizeof(Entry), 1));
+        m_cache = std::make_unique<Entry[]>(m_cache_size);
+    }
+}
+
+auto Perft::run(const chesscore::Position &position, int depth) -> PerftResult {
+    const auto start = std::chrono::steady_clock::now();
+    PerftResult result{.depth = depth};
+    const EnginePosition root{position};
+    if (depth <= 0) {
+        result.nodes = 1;
+        return result;
+    }
+
+    GeneratedMoves moves;
+    MoveGenerator{root}.generate_legal_moves(moves);
+    std::vector<std::uint64_t> counts(moves.size(), 0);
+    std::atomic<std::size_t> next_move{0};
+    const auto count_root_moves = [&]() -> void {
+        EnginePosition thread_position{root};
+        for (auto index = next_move.fetch_add(1); index < moves.size(); index = next_move.fetch_add(1)) {
+            if (depth == 1) {
+                counts[index] = 1;
+            } else {
+                MoveScope scope{thread_position, moves[index]};
+                counts[index] = count(thread_position, depth - 1);
+            }
+        }
+    };
+
+    const auto thread_count = std::clamp<std::size_t>(m_config.threads, 1, std::max<std::size_t>(moves.size(), 1));
+    std::vector<std::thread> helper_threads;
+    helper_threads.reserve(thread_count - 1);
+    for (std::size_t thread = 1; thread < thread_count; ++thread) {
+        helper_threads.emplace_back(count_root_moves);
+    }
+    count_root_moves();
+    for (auto &thread : helper_threads) {
+        thread.join();
+    }
+
+    for (std::size_t index = 0; index < moves.size(); ++index) {
+        result.root_moves.emplace_back(moves[index], counts[index]);
+        result.nodes += counts[index];
+    }
+    result.elapsed_time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    return result;
+}
+
+auto Perft::count(EnginePosition &position, int depth) -> std::uint64_t {
+    const MoveGenerator generator{position};
+    GeneratedMoves moves;
+    if (depth == 1) {
+        generator.generate_legal_moves(moves);
+        return moves.size();
+    }
+
+    const auto key = node_key(position, depth);
+    if (const auto cached = probe(key); cached.has_value()) {
+        return cached.value();
+    }
+    generator.generate_moves(moves);
+    std::uint64_t nodes{0};
+    for (const auto &move : moves) {
+        if (generator.is_legal(move)) {
+            MoveScope scope{position, move};
+            nodes += count(position, depth - 1);
+        }
+    }
+    store(key, nodes);
+    return nodes;
+}
+
+auto Perft::probe(HashKey key) const -> std::optional<std::uint64_t> {
+    if (m_cache_size == 0) {
+        return std::nullopt;
+    }
+    const auto &entry = m_cache[key & (m_cache_size - 1)];
+    const auto nodes = entry.nodes.load(std::memory_order_relaxed);
+    if (nodes != 0 && (entry.check.load(std::memory_order_relaxed) ^ nodes) == key) {
+        return nodes;
+    }
+    return std::nullopt;
+}
+
+auto Perft::store(HashKey key, std::uint64_t nodes) -> void {
+    if (m_cache_size == 0) {
+        return;
+    }
+    auto &entry = m_cache[key & (m_cache_size - 1)];
+    entry.check.store(key ^ nodes, std::memory_order_relaxed);
+    entry.nodes.store(nodes, std::memory_order_relaxed);
+}
+
+auto to_string(const PerftResult &result, bool divide) -> std::string {
+    std::string report;
+    if (divide) {
+        for (const auto &[move, nodes] : result.root_moves) {
+            report += std::format("{}: {}\n", to_string(chessuci::UCIMove{move}), nodes);
+        }
+        report += '\n';
+    }
+    report += std::format("Nodes searched: {}\n", result.nodes);
+    report += std::format("Time: {} ms\n", result.elapsed_time.count());
+    const auto nps = result.calculate_nps();
+    report += std::format("Nodes/second: {}\n", nps.has_value() ? std::to_string(nps.value()) : "-");
+    return report;
+}
+
+} // namespace chessengine
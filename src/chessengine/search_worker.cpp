@@ -0,0 +1,810 @@
+/* ************************************************************************** *
+ * Chess Engine Maat                                                          *
+ * Chess playing engine                                                       *
+ * ************************************************************************** */
+
+#include "chessengine/search_worker.h"
+#include "chessengine/logger.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace chessengine {
+
+namespace {
+
+constexpr PawnEntry no_pawn_structure{}; ///< Pawn hash entry, when the pawn structure is not evaluated.
+
+/**
+ * \brief Classify a search result with respect to the search window.
+ *
+ * \param score The best score found in a position.
+ * \param alpha The lower bound of the search window when entering the position.
+ * \param beta The upper bound of the search window.
+ * \return The kind of the score.
+ */
+auto score_bound(Score score, Score alpha, Score beta) -> ScoreBound {
+    if (score <= alpha) {
+        return ScoreBound::Upper;
+    }
+    if (score >= beta) {
+        return ScoreBound::Lower;
+    }
+    return ScoreBound::Exact;
+}
+
+/**
+ * \brief Limit a bound of an aspiration window to the range of scores.
+ *
+ * \param value The bound.
+ * \return The bound as score.
+ */
+auto window_bound(int value) -> Score {
+    return Score{static_cast<Score::value_type>(std::clamp<int>(value, Score::NegInfinity.value, Score::Infinity.value))};
+}
+
+/**
+ * \brief Check, if a stored result determines the score for the current window.
+ *
+ * \param entry The entry from the transposition table.
+ * \param bounds The current search window.
+ * \return If the stored score can be returned without searching.
+ */
+auto is_cutoff(const TranspositionEntry &entry, const Bounds &bounds) -> bool {
+    switch (entry.bound) {
+    case ScoreBound::Exact:
+        return true;
+    case ScoreBound::Lower:
+        return entry.score >= bounds.beta;
+    case ScoreBound::Upper:
+        return entry.score <= bounds.alpha;
+    default:
+        return false;
+    }
+}
+
+/**
+ * \brief Check, if a move is quiet.
+ *
+ * Quiet moves neither capture nor promote. Only those are subject to the
+ * killer, countermove and history heuristics.
+ * \param move The move.
+ * \return If the move is quiet.
+ */
+auto is_quiet(const chesscore::Move &move) -> bool {
+    return !move.is_capture() && !move.is_pawn_promotion();
+}
+
+/**
+ * \brief Check, if a side has pieces other than king and pawns.
+ *
+ * Positions with only king and pawns are prone to zugzwang.
+ * \param board The pieces of the position.
+ * \param color The side.
+ * \return If the side has a knight, bishop, rook or queen.
+ */
+auto has_non_pawn_material(const BoardBitboards &board, chesscore::Color color) -> bool {
+    return (board.pieces(color) & ~(board.pieces(chesscore::PieceType::Pawn) | board.pieces(chesscore::PieceType::King))) != 0;
+}
+
+constexpr std::size_t reduction_table_size{64}; ///< Number of depths and move numbers in the reduction table.
+
+/**
+ * \brief Late move reduction for a move.
+ *
+ * The reduction grows logarithmically with both the remaining depth and the
+ * number of the move in the move order. The table is computed once on first
+ * use.
+ * \param depth The remaining depth.
+ * \param move_number Number of the move in the move order (starting at 1).
+ * \return The reduction.
+ */
+auto reduction_table_entry(Depth depth, std::size_t move_number) -> Depth {
+    using ReductionTable = std::array<std::array<Depth::value_type, reduction_table_size>, reduction_table_size>;
+    static const ReductionTable reductions = [] {
+        ReductionTable table{};
+        for (std::size_t d = 1; d < reduction_table_size; ++d) {
+            for (std::size_t m = 1; m < reduction_table_size; ++m) {
+                table[d][m] = static_cast<Depth::value_type>(0.75 + std::log(static_cast<double>(d)) * std::log(static_cast<double>(m)) / 2.25);
+            }
+        }
+        return table;
+    }();
+    const auto depth_index = std::min(static_cast<std::size_t>(std::max<Depth::value_type>(depth.value, 0)), reduction_table_size - 1);
+    return Depth{reductions[depth_index][std::min(move_number, reduction_table_size - 1)]};
+}
+
+/**
+ * \brief Depth reduction for the null move search.
+ *
+ * Adaptive null move pruning: the reduction is larger for deeper searches,
+ * where the saved work is largest.
+ * \param depth The remaining depth.
+ * \return The reduction.
+ */
+auto null_move_reduction(Depth depth) -> Depth {
+    return depth > Depth{6} ? Depth{3} : Depth{2};
+}
+
+} // namespace
+
+SearchWorker::SearchWorker(
+    int id, const Config &config, const Evaluator &evaluator, TranspositionTable &transposition_table, SearchSharedState &shared_state,
+    const std::atomic<bool> &stop_requested
+)
+    : m_id{id}, m_config{config}, m_evaluator{evaluator}, m_transposition_table{transposition_table}, m_shared_state{shared_state}, m_stop_requested{stop_requested},
+      m_eval_cache{config.search_config.eval_cache_size_mb} {}
+
+auto SearchWorker::prepare(const EnginePosition &position, const StopParameters &stop_params, std::chrono::steady_clock::time_point search_start) -> void {
+    m_position = position;
+    m_position.set_piece_square_values(&m_evaluator.piece_square_values());
+    m_stopping_params = stop_params;
+    m_search_start = search_start;
+    m_search_stats = {};
+    m_best_move = {};
+    m_check_counter = 0;
+    m_published_nodes = 0;
+    m_aborted = false;
+    m_stack.clear();
+    m_history.clear();
+    m_countermoves.clear();
+    m_null_move_min_ply = 0;
+    // A size of 0 switches the cache off and releases its entries.
+    if (m_eval_cache.size_mb() != m_config.search_config.eval_cache_size_mb) {
+        m_eval_cache.resize(m_config.search_config.eval_cache_size_mb);
+    }
+}
+
+auto SearchWorker::search() -> void {
+    // If iterative_deepening is not used, the max_search_depth should be set!
+    auto search_depth = m_config.search_config.iterative_deepening ? Depth{1} : m_stopping_params.max_search_depth;
+    if (m_config.search_config.iterative_deepening && !is_main()) {
+        // Let half of the helpers start one ply deeper, so that the threads do not all search the same tree.
+        search_depth += Depth{static_cast<Depth::value_type>(m_id % 2)};
+    }
+    while (m_stopping_params.max_search_depth == Depth::Zero || search_depth <= m_stopping_params.max_search_depth) {
+        if (check_stop()) {
+            break;
+        }
+        log_search_stream() << "[" << m_id << "] Searching for depth: " << search_depth;
+        log_indent();
+        auto best_move = aspiration_search(search_depth);
+        log_unindent();
+        if (m_aborted) {
+            // Keep the result, if at least the first root move (usually the best move of the previous iteration) has been searched completely.
+            if (!best_move.pv.empty()) {
+                log_search_stream() << "[" << m_id << "] Keeping partial result of depth " << search_depth << ": " << to_string(best_move.move) << " (" << best_move.score << ')';
+                m_best_move = std::move(best_move);
+                m_search_stats.best_move = m_best_move;
+            }
+            break;
+        }
+        m_best_move = std::move(best_move);
+        log_search_stream() << "[" << m_id << "] Search for depth " << search_depth << " finishd with best move: " << to_string(m_best_move.move) << " ("
+                            << m_best_move.score << ')';
+        m_search_stats.depth = search_depth;
+        m_search_stats.best_move = m_best_move;
+        m_search_stats.elapsed_time = search_time();
+        if (m_progress_callback) {
+            m_progress_callback(m_search_stats);
+        }
+        if (is_proven_mate(m_best_move.score, search_depth)) {
+            log_search_stream() << "[" << m_id << "] Stopping search at proven mate score " << m_best_move.score;
+            break;
+        }
+        search_depth += Depth::Step;
+    }
+    if (is_main() && !m_aborted) {
+        stop("Search finished");
+    }
+    log_search_stream() << "[" << m_id << "] Search stopped";
+    m_search_stats.elapsed_time = search_time();
+    publish_nodes();
+}
+
+auto SearchWorker::aspiration_search(Depth depth) -> EvaluatedMove {
+    const auto &config = m_config.search_config;
+    const auto previous_score = m_best_move.score;
+    if (!config.use_aspiration_windows || !m_config.minimax_config.use_alpha_beta_pruning || m_best_move.pv.empty() || is_decisive_score(previous_score)) {
+        return search_position(depth, Bounds{});
+    }
+
+    auto delta = static_cast<int>(config.aspiration_window.value);
+    Bounds bounds{window_bound(previous_score.value - delta), window_bound(previous_score.value + delta)};
+    while (true) {
+        log_search_stream() << "[" << m_id << "] Aspiration window " << bounds.alpha << " .. " << bounds.beta;
+        auto result = search_position(depth, bounds);
+        const auto bound = score_bound(result.score, bounds.alpha, bounds.beta);
+        if (m_aborted) {
+            if (bound == ScoreBound::Upper) {
+                // A partial result below the window does not tell anything about the best move.
+                result.pv.clear();
+            }
+            return result;
+        }
+        if (bound == ScoreBound::Exact || (bounds.alpha == Score::NegInfinity && bounds.beta == Score::Infinity)) {
+            return result;
+        }
+        report_bound(depth, result, bound);
+        if (is_decisive_score(result.score)) {
+            // Mate scores are only reliable when searched with the full window.
+            bounds = Bounds{};
+            continue;
+        }
+        delta *= 2;
+        if (bound == ScoreBound::Upper) {
+            bounds.beta = window_bound((bounds.alpha.value + bounds.beta.value) / 2);
+            bounds.alpha = window_bound(result.score.value - delta);
+        } else {
+            bounds.beta = window_bound(result.score.value + delta);
+        }
+    }
+}
+
+auto SearchWorker::report_bound(Depth depth, const EvaluatedMove &result, ScoreBound bound) -> void {
+    log_search_stream() << "[" << m_id << "] Search failed " << (bound == ScoreBound::Upper ? "low" : "high") << " with score " << result.score;
+    if (!m_progress_callback) {
+        return;
+    }
+    auto search_stats = m_search_stats;
+    search_stats.depth = depth;
+    search_stats.score_bound = bound;
+    search_stats.elapsed_time = search_time();
+    if (bound == ScoreBound::Lower) {
+        // The move refuting the window is at least as good as the previous best move.
+        search_stats.best_move = result;
+    } else {
+        search_stats.best_move.score = result.score;
+    }
+    m_progress_callback(search_stats);
+}
+
+auto SearchWorker::search_position(Depth depth, Bounds bounds) -> EvaluatedMove {
+    EvaluatedMove best_move{.move = {}, .score = Score::NegInfinity};
+    const auto original_alpha = bounds.alpha;
+    m_pv_table.clear(0);
+    m_follow_pv = m_config.search_config.search_pv_first;
+    const auto first_move = first_move_to_search(0, PackedMove{});
+    const auto follow_pv = m_follow_pv;
+    const MoveGenerator generator{m_position};
+    auto moves = move_picker(generator, first_move, 0);
+    log_search_stream() << "Searching " << moves.size() << " pseudo-legal moves for " << to_string(m_position.side_to_move());
+    std::size_t move_count{0};
+    while (const auto next_move = moves.next()) {
+        const auto &move = next_move.value();
+        {
+            const auto is_first_move = move_count++ == 0;
+            log_search_stream() << "Checking move " << to_string(move) << " for " << to_string(m_position.side_to_move()) << " at depth " << depth;
+            log_indent();
+            m_stack[0].current_move = move;
+            MoveScope scope{m_position, move};
+            m_follow_pv = follow_pv && is_first_move && first_move.matches(move);
+            const auto extension = check_extension(0);
+            const auto value = search_move(depth + extension, bounds, 0, is_first_move, Depth::Zero);
+            m_follow_pv = false;
+            log_unindent();
+            if (m_aborted) {
+                break;
+            }
+            log_search_stream() << "Move " << to_string(move) << " for " << to_string(m_position.side_to_move()) << " evaluated to " << value;
+            if (value > best_move.score) {
+                log_search_stream() << "Found new best move for " << to_string(m_position.side_to_move()) << ": " << to_string(move) << " (" << value << ") replacing "
+                                    << to_string(best_move.move) << " (" << best_move.score << ")";
+                best_move = {.move = move, .score = value};
+                m_pv_table.update(0, move);
+            }
+        }
+        bounds.alpha = std::max(bounds.alpha, best_move.score);
+        if (m_config.minimax_config.use_alpha_beta_pruning && (bounds.beta <= bounds.alpha)) {
+            log_search("Cancelling search");
+            m_search_stats.cutoffs += 1;
+            break;
+        }
+        if (check_stop()) {
+            break;
+        }
+    }
+    m_search_stats.nodes += 1;
+    best_move.pv = m_pv_table.line();
+    if (m_aborted) {
+        return best_move;
+    }
+    if (m_config.minimax_config.use_transposition_table) {
+        const auto bound = score_bound(best_move.score, original_alpha, bounds.beta);
+        const auto stored_move = bound == ScoreBound::Upper ? PackedMove{} : PackedMove{best_move.move};
+        m_transposition_table.store(m_position.key(), TranspositionEntry{.move = stored_move, .score = best_move.score, .depth = depth, .bound = bound});
+    }
+
+    return best_move;
+}
+
+auto SearchWorker::search_position(Depth depth, Bounds bounds, std::size_t ply) -> Score {
+    m_pv_table.clear(ply);
+    if (m_position.is_draw()) {
+        log_search_stream() << "Draw by repetition or fifty-move rule";
+        return Score{0};
+    }
+    if (m_config.evaluator_config.use_endgame_knowledge && material_entry().draw) {
+        log_search_stream() << "Draw by insufficient material";
+        return Score{0};
+    }
+    if (m_config.minimax_config.use_mate_distance_pruning) {
+        // No line can be better than mating with the next move, or worse than being mated right now.
+        bounds.alpha = std::max(bounds.alpha, -Score::Mate);
+        bounds.beta = std::min(bounds.beta, Score::Mate - Depth::Step);
+        if (bounds.alpha >= bounds.beta) {
+            return bounds.alpha;
+        }
+    }
+    if ((depth == Depth::Zero) || ply + 1 >= PVTable::max_ply) {
+        if (m_config.minimax_config.use_quiescence_search) {
+            return quiescence_search(bounds, ply);
+        }
+        const auto eval = leaf_evaluation();
+        log_search_stream() << "Search stopped by depth. Position evaluation: " << eval;
+        return eval;
+    }
+
+    const auto original_alpha = bounds.alpha;
+    PackedMove hash_move{};
+    if (m_config.minimax_config.use_transposition_table) {
+        const auto entry = m_transposition_table.probe(m_position.key());
+        if (entry.has_value()) {
+            hash_move = entry->move;
+            if (entry->depth >= depth && is_cutoff(entry.value(), bounds)) {
+                log_search_stream() << "Transposition table hit. Stored evaluation: " << entry->score;
+                m_search_stats.tt_hits += 1;
+                return entry->score;
+            }
+        }
+    }
+
+    m_stack[ply].static_eval = pruning_evaluation(bounds);
+    const auto &static_eval = m_stack[ply].static_eval;
+    if (static_eval.has_value()) {
+        const auto pruned_score = prune_node(depth, bounds, ply, static_eval.value());
+        if (pruned_score.has_value()) {
+            return pruned_score.value();
+        }
+    }
+
+    if (null_move_allowed(depth, bounds, ply, static_eval)) {
+        const auto null_move_score = null_move_search(depth, bounds, ply);
+        if (m_aborted) {
+            return Score{0};
+        }
+        if (null_move_score.has_value()) {
+            log_search_stream() << "Null move cutoff: " << null_move_score.value();
+            m_search_stats.cutoffs += 1;
+            return null_move_score.value();
+        }
+    }
+
+    const auto first_move = first_move_to_search(ply, hash_move);
+    const auto follow_pv = m_follow_pv;
+    const MoveGenerator generator{m_position};
+    auto moves = move_picker(generator, first_move, ply);
+    log_search_stream() << "Searching " << moves.size() << " pseudo-legal moves for " << to_string(m_position.side_to_move());
+    log_search_stream() << "Alpha = " << bounds.alpha << " Beta = " << bounds.beta;
+
+    auto best_value = Score::NegInfinity;
+    PackedMove best_move{};
+    std::size_t move_count{0};
+    std::array<chesscore::Move, max_penalized_quiets> quiets_searched;
+    std::size_t quiet_count{0};
+    while (const auto next_move = moves.next()) {
+        const auto &move = next_move.value();
+        if (check_stop()) {
+            return Score{0};
+        }
+        const auto is_first_move = move_count++ == 0;
+        if (!is_first_move && static_eval.has_value() && !is_losing_score(best_value) && prune_move(depth, bounds, static_eval.value(), move_count, move, moves.stage())) {
+            log_search_stream() << "Pruning move " << to_string(move);
+            continue;
+        }
+        log_search_stream() << "Checking move " << to_string(move) << " for " << to_string(m_position.side_to_move()) << " at depth " << depth;
+        {
+            log_indent();
+            m_stack[ply].current_move = move;
+            MoveScope scope{m_position, move};
+            m_follow_pv = follow_pv && is_first_move && first_move.matches(move);
+            const auto extension = check_extension(ply);
+            const auto reduction = extension > Depth::Zero ? Depth::Zero : late_move_reduction(depth, move_count, move, moves.stage());
+            const auto value = search_move(depth + extension, bounds, ply, is_first_move, reduction);
+            m_follow_pv = false;
+            log_unindent();
+            if (m_aborted) {
+                return Score{0};
+            }
+            log_search_stream() << "Move " << to_string(move) << " for " << to_string(m_position.side_to_move()) << " evaluated to " << value;
+            if (value > best_value) {
+                best_value = value;
+                best_move = PackedMove{move};
+            }
+            if (bounds.alpha < best_value) {
+                log_search_stream() << "Updated alpha from " << bounds.alpha << " to " << best_value << "; beta = " << bounds.beta;
+                m_pv_table.update(ply, move);
+            }
+        }
+        bounds.alpha = std::max(bounds.alpha, best_value);
+        if (m_config.minimax_config.use_alpha_beta_pruning && (bounds.beta <= bounds.alpha)) {
+            log_search("Cancelling search");
+            m_search_stats.cutoffs += 1;
+            if (is_first_move) {
+                m_search_stats.first_move_cutoffs += 1;
+            }
+            if (is_quiet(move)) {
+                update_quiet_move_history(depth, ply, move, std::span{quiets_searched.data(), quiet_count});
+            }
+            break;
+        }
+        if (is_quiet(move) && quiet_count < quiets_searched.size()) {
+            quiets_searched[quiet_count++] = move;
+        }
+    }
+    m_search_stats.nodes += 1;
+    if (move_count == 0) {
+        const auto eval = Evaluator::terminal_score(generator.in_check());
+        log_search_stream() << "No legal moves. Position evaluation: " << eval;
+        return eval;
+    }
+    if (m_config.minimax_config.use_transposition_table) {
+        const auto bound = score_bound(best_value, original_alpha, bounds.beta);
+        const auto stored_move = bound == ScoreBound::Upper ? PackedMove{} : best_move;
+        m_transposition_table.store(m_position.key(), TranspositionEntry{.move = stored_move, .score = best_value, .depth = depth, .bound = bound});
+    }
+    return best_value;
+}
+
+auto SearchWorker::search_move(Depth depth, Bounds bounds, std::size_t ply, bool first_move, Depth reduction) -> Score {
+    const auto child_depth = depth - Depth::Step;
+    if (reduction > Depth::Zero) {
+        m_search_stats.reduced_moves += 1;
+        const auto value = adjust_mate_distance(-search_position(child_depth - reduction, child_bounds(bounds.zero_window()), ply + 1));
+        if (m_aborted || value <= bounds.alpha) {
+            return value;
+        }
+        log_search_stream() << "Reduced search failed high (" << value << "), searching again with full depth";
+        m_search_stats.re_searches += 1;
+    }
+    if (first_move || !m_config.minimax_config.use_principal_variation_search || !m_config.minimax_config.use_alpha_beta_pruning) {
+        return adjust_mate_distance(-search_position(child_depth, child_bounds(bounds), ply + 1));
+    }
+    auto value = adjust_mate_distance(-search_position(child_depth, child_bounds(bounds.zero_window()), ply + 1));
+    if (!m_aborted && value > bounds.alpha && value < bounds.beta) {
+        log_search_stream() << "Zero window search failed high (" << value << "), searching again with full window";
+        value = adjust_mate_distance(-search_position(child_depth, child_bounds(bounds), ply + 1));
+    }
+    return value;
+}
+
+auto SearchWorker::check_extension(std::size_t ply) -> Depth {
+    const auto &config = m_config.minimax_config;
+    const auto extensions = m_stack[ply].extensions;
+    m_stack[ply + 1].extensions = extensions;
+    if (!config.use_check_extensions || extensions >= config.max_check_extensions) {
+        return Depth::Zero;
+    }
+    // The move is already made, so this checks, if it gives check.
+    if (!m_position.in_check()) {
+        return Depth::Zero;
+    }
+    m_stack[ply + 1].extensions = extensions + 1;
+    return Depth::Step;
+}
+
+auto SearchWorker::late_move_reduction(Depth depth, std::size_t move_number, const chesscore::Move &move, MovePicker::Stage stage) const -> Depth {
+    const auto &config = m_config.minimax_config;
+    if (!config.use_late_move_reductions || !config.use_alpha_beta_pruning || depth < config.late_move_reduction_min_depth ||
+        move_number <= config.late_move_reduction_min_moves) {
+        return Depth::Zero;
+    }
+    if (!is_quiet(move) || stage == MovePicker::Stage::HashMove || stage == MovePicker::Stage::Killers) {
+        return Depth::Zero;
+    }
+    // The move is already made, so this checks, if it gives check.
+    if (m_position.in_check()) {
+        return Depth::Zero;
+    }
+    // Always leave at least one ply for the reduced search.
+    return std::min(reduction_table_entry(depth, move_number), depth - Depth{2});
+}
+
+auto SearchWorker::first_move_to_search(std::size_t ply, PackedMove hash_move) const -> PackedMove {
+    if (m_follow_pv && ply < m_best_move.pv.size()) {
+        return PackedMove{m_best_move.pv[ply]};
+    }
+    return hash_move;
+}
+
+auto SearchWorker::pruning_evaluation(const Bounds &bounds) -> std::optional<Score> {
+    if (!m_config.minimax_config.use_alpha_beta_pruning || m_follow_pv || is_decisive_score(bounds.alpha) || is_decisive_score(bounds.beta)) {
+        return std::nullopt;
+    }
+    // Principal variation search only opens the window for nodes that may be on the principal variation.
+    const auto pv_node = bounds.beta.value - bounds.alpha.value > 1;
+    if (pv_node || m_position.in_check()) {
+        return std::nullopt;
+    }
+    return static_evaluation();
+}
+
+auto SearchWorker::static_evaluation() -> Score {
+    const auto use_eval_cache = m_config.minimax_config.use_eval_cache && !m_eval_cache.empty();
+    if (use_eval_cache) {
+        m_search_stats.eval_cache_probes += 1;
+        if (const auto cached = m_eval_cache.probe(m_position.key()); cached.has_value()) {
+            m_search_stats.eval_cache_hits += 1;
+            return cached.value();
+        }
+    }
+    const auto &pawns = m_config.evaluator_config.use_pawn_structure ? pawn_entry() : no_pawn_structure;
+    const auto score = m_evaluator.static_evaluation(m_position, pawns, material_entry(), m_position.side_to_move());
+    // The wrapped position is not updated below a null move, so it cannot be checked there.
+    assert((m_position.in_null_move() || score == m_evaluator.static_evaluation(m_position.position(), m_position.side_to_move())) &&
+           "incremental evaluation differs from the full evaluation");
+    if (use_eval_cache) {
+        m_eval_cache.store(m_position.key(), score);
+    }
+    return score;
+}
+
+auto SearchWorker::pawn_entry() -> const PawnEntry & {
+    const auto key = m_position.pawn_key();
+    auto &entry = m_pawn_table.entry(key);
+    m_search_stats.pawn_hash_probes += 1;
+    if (m_evaluator.update_pawn_entry(m_position.board(), key, entry)) {
+        m_search_stats.pawn_hash_hits += 1;
+    }
+    return entry;
+}
+
+auto SearchWorker::material_entry() -> const MaterialEntry & {
+    const auto key = m_position.material_key();
+    auto &entry = m_material_table.entry(key);
+    if (entry.key != key) {
+        entry = m_evaluator.material_entry(m_position.board());
+        entry.key = key;
+    }
+    return entry;
+}
+
+auto SearchWorker::leaf_evaluation() -> Score {
+    // Only a king in check can be mated; stalemates are not detected at the leaves.
+    if (m_position.in_check() && !MoveGenerator{m_position}.has_legal_moves()) {
+        return -Score::Mate;
+    }
+    return static_evaluation();
+}
+
+auto SearchWorker::prune_node(Depth depth, const Bounds &bounds, std::size_t ply, Score static_eval) -> std::optional<Score> {
+    const auto &config = m_config.minimax_config;
+    if (depth > config.shallow_pruning_max_depth) {
+        return std::nullopt;
+    }
+    if (config.use_reverse_futility_pruning && static_eval - config.reverse_futility_margin * depth.value >= bounds.beta) {
+        log_search_stream() << "Reverse futility pruning. Static evaluation: " << static_eval;
+        m_search_stats.nodes += 1;
+        return static_eval;
+    }
+    if (config.use_razoring && config.use_quiescence_search && static_eval + config.razoring_margin * depth.value < bounds.alpha) {
+        const auto value = quiescence_search(bounds, ply);
+        if (value <= bounds.alpha) {
+            log_search_stream() << "Razoring. Quiescence search: " << value;
+            return value;
+        }
+    }
+    return std::nullopt;
+}
+
+auto SearchWorker::prune_move(Depth depth, const Bounds &bounds, Score static_eval, std::size_t move_number, const chesscore::Move &move, MovePicker::Stage stage) const
+    -> bool {
+    const auto &config = m_config.minimax_config;
+    if (depth > config.shallow_pruning_max_depth || stage == MovePicker::Stage::HashMove || stage == MovePicker::Stage::Killers) {
+        return false;
+    }
+    if (stage == MovePicker::Stage::LosingCaptures) {
+        return config.use_see_pruning && m_evaluator.see(m_position.board(), move) < -(config.see_pruning_margin * depth.value);
+    }
+    if (!is_quiet(move)) {
+        return false;
+    }
+    const auto depth_squared = static_cast<std::size_t>(depth.value * depth.value);
+    if (config.use_late_move_pruning && move_number > config.late_move_pruning_base + depth_squared) {
+        return true;
+    }
+    return config.use_futility_pruning && static_eval + config.futility_margin * depth.value <= bounds.alpha;
+}
+
+auto SearchWorker::null_move_allowed(Depth depth, const Bounds &bounds, std::size_t ply, std::optional<Score> static_eval) const -> bool {
+    const auto &config = m_config.minimax_config;
+    if (!config.use_null_move_pruning || depth < config.null_move_min_depth || !static_eval.has_value()) {
+        return false;
+    }
+    if (ply < m_null_move_min_ply || m_stack.after_null_move(ply)) {
+        return false;
+    }
+    return static_eval.value() >= bounds.beta && has_non_pawn_material(m_position.board(), m_position.side_to_move());
+}
+
+auto SearchWorker::null_move_search(Depth depth, const Bounds &bounds, std::size_t ply) -> std::optional<Score> {
+    const auto reduction = null_move_reduction(depth);
+    const auto null_move_depth = std::max(depth - Depth::Step - reduction, Depth::Zero);
+    const Bounds null_window{bounds.beta - Score{1}, bounds.beta};
+
+    log_search_stream() << "Trying null move with depth " << null_move_depth;
+    auto value = Score::NegInfinity;
+    {
+        log_indent();
+        m_stack[ply].current_move.reset();
+        m_stack[ply].null_move = true;
+        m_stack[ply + 1].extensions = m_stack[ply].extensions;
+        NullMoveScope scope{m_position};
+        value = adjust_mate_distance(-search_position(null_move_depth, child_bounds(null_window), ply + 1));
+        m_stack[ply].null_move = false;
+        log_unindent();
+    }
+    if (m_aborted || value < bounds.beta) {
+        return std::nullopt;
+    }
+    // A mate found after passing the move is not proven.
+    if (is_winning_score(value)) {
+        value = bounds.beta;
+    }
+    if (depth < m_config.minimax_config.null_move_verification_depth || m_null_move_min_ply > 0) {
+        return value;
+    }
+
+    log_search_stream() << "Verifying null move cutoff with depth " << depth - reduction;
+    m_null_move_min_ply = ply + static_cast<std::size_t>(3 * (depth - reduction).value / 4);
+    const auto verified_value = search_position(depth - reduction, null_window, ply);
+    m_null_move_min_ply = 0;
+    if (m_aborted || verified_value < bounds.beta) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+auto SearchWorker::quiescence_search(Bounds bounds, std::size_t ply) -> Score {
+    m_search_stats.qnodes += 1;
+    const MoveGenerator generator{m_position};
+    const auto in_check = generator.in_check();
+    if (ply + 1 >= max_search_ply) {
+        const auto eval = static_evaluation();
+        log_search_stream() << "Quiescence search reached the maximum ply: " << eval;
+        return eval;
+    }
+
+    // A side in check may not stand pat, it has to try all evasions.
+    auto stand_pat = Score::NegInfinity;
+    if (!in_check) {
+        stand_pat = static_evaluation();
+        // The legal moves are only looked at for a side in check. Only the rare stalemate is missed.
+        if (stand_pat >= bounds.beta) {
+            log_search_stream() << "Quiescence search stands pat: " << stand_pat;
+            return stand_pat;
+        }
+        bounds.alpha = std::max(bounds.alpha, stand_pat);
+    }
+
+    auto best_value = stand_pat;
+    auto moves = in_check ? move_picker(generator, PackedMove{}, ply) : MovePicker::captures(m_stack[ply].moves, generator, m_evaluator);
+    std::size_t move_count{0};
+    while (const auto next_move = moves.next()) {
+        const auto &move = next_move.value();
+        const auto is_first_move = move_count++ == 0;
+        if (check_stop()) {
+            return Score{0};
+        }
+        if (!in_check && m_config.minimax_config.use_see_pruning && moves.stage() == MovePicker::Stage::LosingCaptures) {
+            // Only losing captures are left.
+            break;
+        }
+        if (!in_check && m_config.minimax_config.use_delta_pruning && !move.is_pawn_promotion() &&
+            stand_pat + m_config.evaluator_config.piece_value(move.captured.value().type()) + m_config.minimax_config.delta_pruning_margin < bounds.alpha) {
+            continue;
+        }
+        log_search_stream() << "Checking " << (in_check ? "evasion " : "capture ") << to_string(move) << " for " << to_string(m_position.side_to_move());
+        {
+            log_indent();
+            MoveScope scope{m_position, move};
+            const auto value = adjust_mate_distance(-quiescence_search(child_bounds(bounds), ply + 1));
+            log_unindent();
+            if (m_aborted) {
+                return Score{0};
+            }
+            best_value = std::max(best_value, value);
+        }
+        bounds.alpha = std::max(bounds.alpha, best_value);
+        if (m_config.minimax_config.use_alpha_beta_pruning && (bounds.beta <= bounds.alpha)) {
+            m_search_stats.cutoffs += 1;
+            if (is_first_move) {
+                m_search_stats.first_move_cutoffs += 1;
+            }
+            break;
+        }
+    }
+    if (in_check && move_count == 0) {
+        const auto eval = Evaluator::terminal_score(true);
+        log_search_stream() << "No evasions in quiescence search. Position evaluation: " << eval;
+        return eval;
+    }
+    return best_value;
+}
+
+auto SearchWorker::move_picker(const MoveGenerator &generator, PackedMove first_move, std::size_t ply) -> MovePicker {
+    MoveOrderingHints hints{};
+    if (m_config.minimax_config.use_move_history) {
+        const auto &previous_move = m_stack.previous_move(ply);
+        hints = {
+            .killers = m_stack[ply].killers,
+            .countermove = previous_move.has_value() ? m_countermoves.get(previous_move.value()) : PackedMove{},
+            .history = &m_history,
+        };
+    }
+    return MovePicker{m_stack[ply].moves, generator, m_evaluator, first_move, hints, m_config.minimax_config.use_move_ordering};
+}
+
+auto SearchWorker::update_quiet_move_history(Depth depth, std::size_t ply, const chesscore::Move &move, std::span<const chesscore::Move> quiets_searched) -> void {
+    if (!m_config.minimax_config.use_move_history) {
+        return;
+    }
+    m_stack[ply].add_killer(move);
+    const auto color = m_position.side_to_move();
+    const auto bonus = HistoryTable::bonus(depth);
+    m_history.update(color, move, bonus);
+    for (const auto &quiet : quiets_searched) {
+        m_history.update(color, quiet, -bonus);
+    }
+    const auto &previous_move = m_stack.previous_move(ply);
+    if (previous_move.has_value()) {
+        m_countermoves.set(previous_move.value(), move);
+    }
+}
+
+auto SearchWorker::search_time() const -> std::chrono::milliseconds {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - m_search_start);
+}
+
+auto SearchWorker::stop(const std::string &reason) -> void {
+    log_search("STOPPING. " + reason);
+    m_shared_state.stop.store(true, std::memory_order_relaxed);
+    m_aborted = true;
+}
+
+auto SearchWorker::publish_nodes() -> void {
+    if (is_main()) {
+        return;
+    }
+    const auto nodes = m_search_stats.total_nodes();
+    m_shared_state.helper_nodes.fetch_add(nodes - m_published_nodes, std::memory_order_relaxed);
+    m_published_nodes = nodes;
+}
+
+auto SearchWorker::check_stop() -> bool {
+    if (m_aborted) {
+        return true;
+    }
+    if (m_shared_state.stop.load(std::memory_order_relaxed)) {
+        m_aborted = true;
+        return true;
+    }
+    if (!is_main()) {
+        if (++m_check_counter > publish_interval) {
+            m_check_counter = 0;
+            publish_nodes();
+        }
+        return false;
+    }
+
+    if (m_stop_requested.load(std::memory_order_relaxed)) {
+        stop("Stop requested");
+    } else if (m_stopping_params.max_search_nodes > 0 &&
+               m_search_stats.total_nodes() + m_shared_state.helper_nodes.load(std::memory_order_relaxed) > m_stopping_params.max_search_nodes) {
+        stop("Max search nodes reached");
+    }
+    return m_aborted;
+}
+
+} // namespace chessengine
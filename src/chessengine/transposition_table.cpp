@@ -0,0 +1,129 @@
+/* ************************************************************************** *
+ * Chess Engine Maat                                                          *
+ * Chess playing engine                                                       *
+ * ************************************************************************** */
+
+#include "chessengine/transposition_table.h"
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+
+namespace chessengine {
+
+namespace {
+
+constexpr unsigned int score_shift{16U};
+constexpr unsigned int depth_shift{32U};
+constexpr unsigned int generation_shift{48U};
+constexpr unsigned int bound_shift{56U};
+constexpr std::uint64_t word_mask{0xFFFFU};
+constexpr std::uint64_t byte_mask{0xFFU};
+constexpr int age_weight{8}; ///< How many plies of depth one search generation of age is worth.
+
+auto pack(const TranspositionEntry &entry, std::uint8_t generation) -> std::uint64_t {
+    return static_cast<std::uint64_t>(entry.move.bits()) | (static_cast<std::uint64_t>(static_cast<std::uint16_t>(entry.score.value)) << score_shift) |
+           (static_cast<std::uint64_t>(static_cast<std::uint16_t>(entry.depth.value)) << depth_shift) | (static_cast<std::uint64_t>(generation) << generation_shift) |
+           (static_cast<std::uint64_t>(entry.bound) << bound_shift);
+}
+
+auto unpack(std::uint64_t data) -> TranspositionEntry {
+    return TranspositionEntry{
+        .move = PackedMove{static_cast<std::uint16_t>(data & word_mask)},
+        .score = Score{static_cast<Score::value_type>(static_cast<std::uint16_t>((data >> score_shift) & word_mask))},
+        .depth = Depth{static_cast<Depth::value_type>(static_cast<std::uint16_t>((data >> depth_shift) & word_mask))},
+        .bound = static_cast<ScoreBound>((data >> bound_shift) & byte_mask),
+    };
+}
+
+auto generation_of(std::uint64_t data) -> std::uint8_t {
+    return static_cast<std::uint8_t>((data >> generation_shift) & byte_mask);
+}
+
+auto is_used(std::uint64_t data) -> bool {
+    return static_cast<ScoreBound>((data >> bound_shift) & byte_mask) != ScoreBound::None;
+}
+
+} // namespace
+
+PackedMove::PackedMove(const chesscore::Move &move) {
+    constexpr unsigned int to_shift{6U};
+    constexpr unsigned int promotion_shift{12U};
+    const auto promotion = move.promoted.has_value() ? get_index(move.promoted.value().type()) + 1 : 0;
+    m_bits = static_cast<std::uint16_t>(move.from.index() | (move.to.index() << to_shift) | (promotion << promotion_shift));
+}
+
+auto TranspositionTable::resize(std::size_t size_mb) -> void {
+    constexpr std::size_t bytes_per_mb{1024 * 1024};
+    m_size_mb = std::max<std::size_t>(size_mb, 1);
+    m_bucket_count = std::bit_floor(std::max<std::size_t>(m_size_mb * bytes_per_mb / sizeof(Bucket), 1));
+    m_buckets = std::make_unique<Bucket[]>(m_bucket_count);
+}
+
+auto TranspositionTable::clear() -> void {
+    for (std::size_t index = 0; index < m_bucket_count; ++index) {
+        for (auto &entry : m_buckets[index].entries) {
+            entry.check.store(0, std::memory_order_relaxed);
+            entry.data.store(0, std::memory_order_relaxed);
+        }
+    }
+    m_generation = 0;
+}
+
+auto TranspositionTable::probe(HashKey key) const -> std::optional<TranspositionEntry> {
+    for (const auto &entry : bucket(key).entries) {
+        const auto data = entry.data.load(std::memory_order_relaxed);
+        if ((entry.check.load(std::memory_order_relaxed) ^ data) == key && is_used(data)) {
+            return unpack(data);
+        }
+    }
+    return std::nullopt;
+}
+
+auto TranspositionTable::store(HashKey key, const TranspositionEntry &entry) -> void {
+    Entry *replace{nullptr};
+    auto replace_value = std::numeric_limits<int>::max();
+    auto new_entry = entry;
+    for (auto &candidate : bucket(key).entries) {
+        const auto data = candidate.data.load(std::memory_order_relaxed);
+        if ((candidate.check.load(std::memory_order_relaxed) ^ data) == key && is_used(data)) {
+            const auto stored = unpack(data);
+            // Keep deeper results of the current search, unless the new result is exact.
+            if (generation_of(data) == m_generation && entry.bound != ScoreBound::Exact && stored.depth.value > entry.depth.value + 2) {
+                return;
+            }
+            if (new_entry.move.empty()) {
+                new_entry.move = stored.move;
+            }
+            replace = &candidate;
+            break;
+        }
+        const auto age = static_cast<std::uint8_t>(m_generation - generation_of(data));
+        const auto value = is_used(data) ? unpack(data).depth.value - age_weight * age : std::numeric_limits<int>::min();
+        if (value < replace_value) {
+            replace_value = value;
+            replace = &candidate;
+        }
+    }
+    const auto data = pack(new_entry, m_generation);
+    replace->check.store(key ^ data, std::memory_order_relaxed);
+    replace->data.store(data, std::memory_order_relaxed);
+}
+
+auto TranspositionTable::hashfull() const -> int {
+    constexpr std::size_t sample_size{1000};
+    std::size_t used{0};
+    std::size_t sampled{0};
+    for (std::size_t index = 0; index < m_bucket_count && sampled < sample_size; ++index) {
+        for (const auto &entry : m_buckets[index].entries) {
+            const auto data = entry.data.load(std::memory_order_relaxed);
+            if (is_used(data) && generation_of(data) == m_generation) {
+                ++used;
+            }
+            ++sampled;
+        }
+    }
+    return sampled == 0 ? 0 : static_cast<int>(used * sample_size / sampled);
+}
+
+} // namespace chessengine
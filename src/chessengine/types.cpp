@@ -22,6 +22,9 @@ const Depth Depth::Infinite{std::numeric_limits<Depth::value_type>::max()};
 auto to_string(const StopParameters &params) -> std::string {
     std::stringstream sstr;
     sstr << "max time: " << params.max_search_time.count() << " ms; max depth: " << params.max_search_depth.value << "; max nodes: " << params.max_search_nodes;
+    if (params.mate_in_moves > 0) {
+        sstr << "; mate in: " << params.mate_in_moves;
+    }
     return sstr.str();
 }
 
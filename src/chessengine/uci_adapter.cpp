@@ -7,10 +7,14 @@
 
 namespace chessengine {
 
+auto start_position(const chessuci::position_command &command) -> chesscore::Position {
+    const auto fen = (command.fen == chessuci::position_command::startpos) ? chesscore::FenString::starting_position() : chesscore::FenString{command.fen};
+    return chesscore::Position{fen};
+}
+
 auto construct_position(const chessuci::position_command &command) -> std::pair<chesscore::Position, UCIMoveList> {
     UCIMoveList move_list{};
-    const auto fen = (command.fen == chessuci::position_command::startpos) ? chesscore::FenString::starting_position() : chesscore::FenString{command.fen};
-    auto position = chesscore::Position{fen};
+    auto position = start_position(command);
     std::ranges::for_each(command.moves, [&position, &move_list](const chessuci::UCIMove &move) -> void {
         const auto matched_move = chessuci::convert_legal_move(move, position);
         if (matched_move.has_value()) {
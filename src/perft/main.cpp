@@ -0,0 +1,148 @@
+/* ************************************************************************** *
+ * Chess Engine Maat                                                          *
+ * Chess playing engine                                                       *
+ * ************************************************************************** */
+
+#include "chessengine/perft.h"
+
+#include <chesscore/fen.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Parameters {
+    std::string fen{"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"};
+    std::string suite_file;
+    int depth{5};
+    int max_depth{0};
+    bool divide{false};
+    chessengine::PerftConfig config{};
+};
+
+/**
+ * \brief A position of the perft suite with the expected node counts.
+ */
+struct SuiteEntry {
+    std::string fen;
+    std::vector<std::pair<int, std::uint64_t>> expected; ///< Depth and number of leaves.
+};
+
+auto read_arguments(int argc, const char *argv[]) -> Parameters {
+    Parameters params;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg{argv[i]};
+        if (arg.starts_with("--depth=")) {
+            params.depth = std::stoi(arg.substr(8));
+        } else if (arg.starts_with("--max-depth=")) {
+            params.max_depth = std::stoi(arg.substr(12));
+        } else if (arg.starts_with("--threads=")) {
+            params.config.threads = std::stoul(arg.substr(10));
+        } else if (arg.starts_with("--hash=")) {
+            params.config.hash_size_mb = std::stoul(arg.substr(7));
+        } else if (arg.starts_with("--suite=")) {
+            params.suite_file = arg.substr(8);
+        } else if (arg == "--divide") {
+            params.divide = true;
+        } else {
+            params.fen = arg;
+        }
+    }
+    return params;
+}
+
+/**
+ * \brief Read a perft suite.
+ *
+ * Each line holds a FEN, followed by the expected counts in the form
+ * ";D<depth> <nodes>". Empty lines and lines starting with '#' are skipped.
+ * \param file_path Path to the suite file.
+ * \return The positions of the suite.
+ */
+auto load_suite(const std::string &file_path) -> std::vector<SuiteEntry> {
+    std::ifstream file{file_path};
+    if (!file.is_open()) {
+        throw std::runtime_error{"Unable to open perft suite: " + file_path};
+    }
+    std::vector<SuiteEntry> suite;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.ends_with('\r')) {
+            line.pop_back();
+        }
+        if (line.empty() || line.starts_with('#')) {
+            continue;
+        }
+        std::istringstream stream{line};
+        SuiteEntry entry;
+        std::getline(stream, entry.fen, ';');
+        entry.fen.erase(entry.fen.find_last_not_of(' ') + 1);
+        std::string count;
+        while (std::getline(stream, count, ';')) {
+            std::istringstream count_stream{count};
+            std::string depth;
+            std::uint64_t nodes{0};
+            count_stream >> depth >> nodes;
+            entry.expected.emplace_back(std::stoi(depth.substr(1)), nodes);
+        }
+        suite.push_back(entry);
+    }
+    return suite;
+}
+
+auto run_suite(const Parameters &params) -> int {
+    const auto suite = load_suite(params.suite_file);
+    chessengine::Perft perft{params.config};
+    int failures{0};
+    std::uint64_t total_nodes{0};
+    std::chrono::milliseconds total_time{0};
+    for (const auto &entry : suite) {
+        const chesscore::Position position{chesscore::FenString{entry.fen}};
+        for (const auto &[depth, expected] : entry.expected) {
+            if (params.max_depth > 0 && depth > params.max_depth) {
+                continue;
+            }
+            const auto result = perft.run(position, depth);
+            total_nodes += result.nodes;
+            total_time += result.elapsed_time;
+            const bool passed = result.nodes == expected;
+            failures += passed ? 0 : 1;
+            std::cout << std::format(
+                "{:<4} depth {:>2} {:>12} nodes {:>8} ms  {}\n", passed ? "OK" : "FAIL", depth, result.nodes, result.elapsed_time.count(), entry.fen
+            );
+            if (!passed) {
+                std::cout << std::format("     expected {} nodes\n", expected);
+            }
+        }
+    }
+    const auto ms = std::max<std::int64_t>(total_time.count(), 1);
+    std::cout << std::format("\n{} failures, {} nodes in {} ms, {} nodes/second\n", failures, total_nodes, total_time.count(), total_nodes * 1000 / static_cast<std::uint64_t>(ms));
+    return failures == 0 ? 0 : 1;
+}
+
+} // namespace
+
+auto main(int argc, const char *argv[]) -> int {
+    try {
+        const auto params = read_arguments(argc, argv);
+        if (!params.suite_file.empty()) {
+            return run_suite(params);
+        }
+        chessengine::Perft perft{params.config};
+        const auto result = perft.run(chesscore::Position{chesscore::FenString{params.fen}}, params.depth);
+        std::cout << to_string(result, params.divide);
+    } catch (const std::exception &error) {
+        std::cerr << error.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
@@ -14,6 +14,12 @@ struct Parameters {
     int thread_count{1};
     std::string first_test_id{""};
     bool debug{false};
+    bool null_move_pruning{true};
+    bool late_move_reductions{true};
+    bool shallow_pruning{true};
+    bool check_extensions{true};
+    bool mate_distance_pruning{true};
+    chessengine::mate_in_x::Solver solver{chessengine::mate_in_x::Solver::Search};
 };
 
 auto read_arguments(int argc, const char *argv[]) -> Parameters {
@@ -28,6 +34,20 @@ auto read_arguments(int argc, const char *argv[]) -> Parameters {
             params.first_test_id = arg.substr(13);
         } else if (arg.starts_with("--debug")) {
             params.debug = true;
+        } else if (arg == "--no-null-move") {
+            params.null_move_pruning = false;
+        } else if (arg == "--no-lmr") {
+            params.late_move_reductions = false;
+        } else if (arg == "--no-shallow-pruning") {
+            params.shallow_pruning = false;
+        } else if (arg == "--no-check-extensions") {
+            params.check_extensions = false;
+        } else if (arg == "--no-mate-distance-pruning") {
+            params.mate_distance_pruning = false;
+        } else if (arg == "--solver=pns") {
+            params.solver = chessengine::mate_in_x::Solver::ProofNumber;
+        } else if (arg == "--solver=search") {
+            params.solver = chessengine::mate_in_x::Solver::Search;
         } else {
             params.input_file = arg;
         }
@@ -37,7 +57,7 @@ auto read_arguments(int argc, const char *argv[]) -> Parameters {
 
 auto main(int argc, const char *argv[]) -> int {
     if (argc < 2) {
-        std::cerr << "Usage: " << argv[0] << "[--threads=<number>] [--log=<file>] [--first-test=<ID>] <input_file>\n";
+        std::cerr << "Usage: " << argv[0] << "[--threads=<number>] [--log=<file>] [--first-test=<ID>] [--no-null-move] [--no-lmr] [--no-shallow-pruning] [--no-check-extensions] [--no-mate-distance-pruning] [--solver=search|pns] <input_file>\n";
         return 1;
     }
 
@@ -48,6 +68,14 @@ auto main(int argc, const char *argv[]) -> int {
             {
                 .use_alpha_beta_pruning = true,
                 .use_move_ordering = true,
+                .use_null_move_pruning = params.null_move_pruning,
+                .use_late_move_reductions = params.late_move_reductions,
+                .use_reverse_futility_pruning = params.shallow_pruning,
+                .use_razoring = params.shallow_pruning,
+                .use_futility_pruning = params.shallow_pruning,
+                .use_late_move_pruning = params.shallow_pruning,
+                .use_check_extensions = params.check_extensions,
+                .use_mate_distance_pruning = params.mate_distance_pruning,
             },
         .search_config =
             {
@@ -58,6 +86,7 @@ auto main(int argc, const char *argv[]) -> int {
     };
     chessengine::mate_in_x::MateInXTest test_runner;
     test_runner.set_config(config);
+    test_runner.set_solver(params.solver);
     if (!params.log_file.empty()) {
         test_runner.set_log(params.log_file);
     }
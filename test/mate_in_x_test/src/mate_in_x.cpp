@@ -6,8 +6,10 @@
 #include "mate_in_x.h"
 
 #include <chessengine/chess_engine.h>
+#include <chessengine/mate_solver.h>
 #include <chessgame/san.h>
 
+#include <atomic>
 #include <cmath>
 #include <future>
 #include <iostream>
@@ -90,12 +92,8 @@ auto MateInXTest::perform_test(const chesscore::EpdRecord &test) -> MateInXResul
     test_result.expected_depth = chessengine::Depth{static_cast<chessengine::Depth::value_type>(test.pv.size())};
     test_result.expected_moves = std::views::transform(test.bm, [&](const auto &move) { return convert_from_san(move, test.position); }) | std::ranges::to<chesscore::MoveList>();
 
-    chessengine::ChessEngine engine{};
-    engine.set_config(m_base_config);
-    engine.set_position(test.position);
-    chessengine::StopParameters stop_params{.max_search_depth = chessengine::Depth{test_result.expected_depth + chessengine::Depth::Step}};
-    const auto result = engine.search(stop_params);
-    test_result.search_stats = engine.search_stats();
+    test_result.search_stats = solve_test(test, test_result.expected_depth);
+    const auto &result = test_result.search_stats.best_move;
     test_result.found_move = result.move;
     if (is_winning_score(result.score)) {
         test_result.found_mate = true;
@@ -104,8 +102,25 @@ auto MateInXTest::perform_test(const chesscore::EpdRecord &test) -> MateInXResul
     return test_result;
 }
 
+auto MateInXTest::solve_test(const chesscore::EpdRecord &test, chessengine::Depth expected_depth) -> chessengine::SearchStats {
+    if (m_solver == Solver::ProofNumber) {
+        const std::atomic<bool> stop_requested{false};
+        chessengine::MateSolver solver{stop_requested};
+        chessengine::EnginePosition position{test.position};
+        return solver.solve(position, (expected_depth.value + 1) / 2, chessengine::StopParameters{}, std::chrono::steady_clock::now());
+    }
+    chessengine::ChessEngine engine{};
+    engine.set_config(m_base_config);
+    engine.set_position(test.position);
+    chessengine::StopParameters stop_params{.max_search_depth = chessengine::Depth{expected_depth + chessengine::Depth::Step}};
+    engine.search(stop_params);
+    return engine.search_stats();
+}
+
 auto MateInXTest::log_result(const MateInXResult &result) -> void {
     ++m_tests_performed;
+    m_total_nodes += result.search_stats.total_nodes();
+    m_total_time += result.search_stats.elapsed_time;
     std::stringstream log_message;
     log_message << "Test " << std::setw(m_places) << m_tests_performed << " (" << std::fixed << std::setw(6) << std::setprecision(2)
                 << (m_tests_performed / static_cast<double>(m_tests.size()) * 100.0F) << " %) [" << result.test_id << "]: ";
@@ -124,7 +139,8 @@ auto MateInXTest::log_result(const MateInXResult &result) -> void {
             ++m_tests_passed;
         }
     }
-    log_message << " (" << result.search_stats.nodes << " nodes, " << result.search_stats.cutoffs << " cutoffs, " << result.search_stats.elapsed_time.count() << " ms, "
+    log_message << " (" << result.search_stats.nodes << " nodes, " << result.search_stats.qnodes << " qnodes, " << result.search_stats.cutoffs << " cutoffs, " << result.search_stats.reduced_moves
+                << " reduced, " << result.search_stats.re_searches << " re-searched, " << result.search_stats.elapsed_time.count() << " ms, "
                 << result.search_stats.calculate_nps().value_or(0) << " nps)\n";
     write_log(log_message.str());
 }
@@ -134,6 +150,11 @@ auto MateInXTest::print_summary() -> void {
         "\nTotal tests: " + std::to_string(m_tests_performed) + "\nTests passed: " + std::to_string(m_tests_passed) +
         "\nTests failed: " + std::to_string(m_tests_performed - m_tests_passed) + "\n"
     );
+    const auto total_ms = m_total_time.count();
+    write_log(
+        "Nodes searched: " + std::to_string(m_total_nodes) + "\nSearch time: " + std::to_string(total_ms) + " ms\nNodes per second: " +
+        std::to_string(total_ms > 0 ? m_total_nodes * 1000 / total_ms : 0) + "\n"
+    );
 }
 
 auto MateInXTest::load_tests(const std::string &test_file_path) -> void {
@@ -163,6 +184,8 @@ auto MateInXTest::write_log(const std::string &message) -> void {
 auto MateInXTest::reset_stats() -> void {
     m_tests_performed = 0;
     m_tests_passed = 0;
+    m_total_nodes = 0;
+    m_total_time = std::chrono::milliseconds{0};
 }
 
 auto MateInXTest::calculate_places() -> void {
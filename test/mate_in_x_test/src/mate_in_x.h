@@ -11,12 +11,19 @@
 #include <chessengine/logger.h>
 #include <chessengine/types.h>
 
+#include <chrono>
+#include <cstdint>
 #include <fstream>
 #include <mutex>
 #include <string>
 
 namespace chessengine::mate_in_x {
 
+enum class Solver {
+    Search,      ///< The regular alpha-beta search of the engine.
+    ProofNumber, ///< The proof-number mate solver.
+};
+
 struct MateInXResult {
     bool found_mate{false};
     chessengine::Depth expected_depth;
@@ -32,6 +39,7 @@ public:
     auto set_log(const std::string &log_file_path) -> void;
     auto set_threads(int thread_count) -> void { m_max_threads = thread_count; }
     auto set_config(const chessengine::Config &config) -> void { m_base_config = config; }
+    auto set_solver(Solver solver) -> void { m_solver = solver; }
     auto enable_debug() -> void { Logger::instance().enable("engine_debug.log"); }
     auto run_tests(const std::string &file_path, const std::string &first_test_id = "") -> void;
 
@@ -44,6 +52,7 @@ private:
     auto calculate_places() -> void;
     auto process_tests(const std::string &first_test_id) -> void;
     auto perform_test(const chesscore::EpdRecord &test) -> MateInXResult;
+    auto solve_test(const chesscore::EpdRecord &test, chessengine::Depth expected_depth) -> chessengine::SearchStats;
     auto log_result(const MateInXResult &result) -> void;
     auto print_summary() -> void;
 
@@ -52,8 +61,11 @@ private:
     int m_places;
     int m_tests_performed{0};
     int m_tests_passed{0};
+    std::int64_t m_total_nodes{0};
+    std::chrono::milliseconds m_total_time{0};
     int m_max_threads{1};
     chessengine::Config m_base_config;
+    Solver m_solver{Solver::Search};
     std::mutex m_log_mutex;
 };
 
@@ -0,0 +1,158 @@
+/* ************************************************************************** *
+ * Chess Engine Maat                                                          *
+ * Chess playing engine                                                       *
+ * ************************************************************************** */
+
+#include <chesscore/fen.h>
+#include <chessengine/chess_engine.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+/// Number of calls of the global operator new, used to verify that the search does not allocate per node.
+std::atomic<std::int64_t> allocation_count{0};
+
+struct Parameters {
+    std::string input_file;
+    int depth{7};
+    std::size_t hash_size_mb{64};
+    std::vector<std::size_t> thread_counts{1, 2, 4, 8, 16};
+};
+
+struct ScalingResult {
+    std::size_t threads{1};
+    std::chrono::milliseconds time{0};
+    std::int64_t nodes{0};
+    std::int64_t allocations{0};
+};
+
+const std::vector<std::string> default_positions{
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "r1bq1rk1/pp2bppp/2n1pn2/3p4/2PP4/2N1PN2/PP1B1PPP/R2QKB1R w KQ - 0 8",
+    "2r3k1/pp3ppp/2n1b3/3p4/3P4/2PB1N2/P4PPP/2R3K1 w - - 0 20",
+    "8/5pk1/6p1/3P4/2p2P2/2P3P1/6K1/8 w - - 0 40",
+};
+
+auto parse_thread_counts(const std::string &list) -> std::vector<std::size_t> {
+    std::vector<std::size_t> thread_counts;
+    std::istringstream stream{list};
+    std::string count;
+    while (std::getline(stream, count, ',')) {
+        thread_counts.push_back(std::stoul(count));
+    }
+    return thread_counts;
+}
+
+auto read_arguments(int argc, const char *argv[]) -> Parameters {
+    Parameters params;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg{argv[i]};
+        if (arg.starts_with("--depth=")) {
+            params.depth = std::stoi(arg.substr(8));
+        } else if (arg.starts_with("--hash=")) {
+            params.hash_size_mb = std::stoul(arg.substr(7));
+        } else if (arg.starts_with("--threads=")) {
+            params.thread_counts = parse_thread_counts(arg.substr(10));
+        } else {
+            params.input_file = arg;
+        }
+    }
+    return params;
+}
+
+auto load_positions(const std::string &file_path) -> std::vector<std::string> {
+    if (file_path.empty()) {
+        return default_positions;
+    }
+    std::ifstream file{file_path};
+    if (!file.is_open()) {
+        throw std::runtime_error{"Unable to open position file: " + file_path};
+    }
+    std::vector<std::string> positions;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (!line.empty() && !line.starts_with('#')) {
+            positions.push_back(line);
+        }
+    }
+    return positions;
+}
+
+auto run(const Parameters &params, const std::vector<std::string> &positions, std::size_t threads) -> ScalingResult {
+    chessengine::Config config{};
+    config.search_config.iterative_deepening = true;
+    config.search_config.hash_size_mb = params.hash_size_mb;
+    config.search_config.threads = threads;
+
+    ScalingResult result{.threads = threads};
+    for (const auto &fen : positions) {
+        // A fresh engine for every position, so that no run profits from the transposition table of a previous one.
+        chessengine::ChessEngine engine{config};
+        engine.set_position(chesscore::Position{chesscore::FenString{fen}});
+        const auto allocations_before = allocation_count.load();
+        engine.search(chessengine::StopParameters{.max_search_depth = chessengine::Depth{static_cast<chessengine::Depth::value_type>(params.depth)}});
+        const auto allocations = allocation_count.load() - allocations_before;
+        const auto &stats = engine.search_stats();
+        result.time += stats.elapsed_time;
+        result.nodes += stats.total_nodes();
+        result.allocations += allocations;
+        std::cout << std::format(
+            "  {:>2} threads: {:>8} ms {:>12} nodes {:>12} allocations  depth {:>2}  {}\n", threads, stats.elapsed_time.count(), stats.total_nodes(), allocations,
+            stats.depth.value, fen
+        );
+    }
+    return result;
+}
+
+} // namespace
+
+auto operator new(std::size_t size) -> void * {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void *memory = std::malloc(size == 0 ? 1 : size); memory != nullptr) {
+        return memory;
+    }
+    throw std::bad_alloc{};
+}
+
+auto operator delete(void *memory) noexcept -> void {
+    std::free(memory);
+}
+
+auto operator delete(void *memory, std::size_t /*size*/) noexcept -> void {
+    std::free(memory);
+}
+
+auto main(int argc, const char *argv[]) -> int {
+    const auto params = read_arguments(argc, argv);
+    const auto positions = load_positions(params.input_file);
+
+    std::cout << "Time to depth " << params.depth << " for " << positions.size() << " positions\n";
+    std::vector<ScalingResult> results;
+    for (const auto threads : params.thread_counts) {
+        results.push_back(run(params, positions, threads));
+    }
+
+    std::cout << "\nThreads      Time [ms]        Nodes        nps  Speedup  Allocs/node\n";
+    for (const auto &result : results) {
+        const auto ms = std::max<std::int64_t>(result.time.count(), 1);
+        const auto speedup = static_cast<double>(results.front().time.count()) / static_cast<double>(ms);
+        const auto allocations_per_node = static_cast<double>(result.allocations) / static_cast<double>(std::max<std::int64_t>(result.nodes, 1));
+        std::cout << std::format(
+            "{:>7} {:>14} {:>12} {:>10} {:>8.2f} {:>12.4f}\n", result.threads, result.time.count(), result.nodes, result.nodes * 1000 / ms, speedup, allocations_per_node
+        );
+    }
+    return 0;
+}
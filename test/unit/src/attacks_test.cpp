@@ -0,0 +1,58 @@
+/* ************************************************************************** *
+ * Chess Engine                                                               *
+ * Chess playing engine                                                       *
+ * ************************************************************************** */
+
+#include <catch2/catch_all.hpp>
+
+#include "chessengine/attacks.h"
+
+#include <chesscore/fen.h>
+
+using namespace chessengine;
+using namespace chesscore;
+
+namespace {
+
+auto bits(std::initializer_list<Square> squares) -> chessengine::Bitboard {
+    chessengine::Bitboard board{0};
+    for (const auto &square : squares) {
+        board |= square_bit(square.index());
+    }
+    return board;
+}
+
+} // namespace
+
+TEST_CASE("Attacks.Knight", "[attacks]") {
+    CHECK(knight_attacks(Square::A1.index()) == bits({Square::B3, Square::C2}));
+    CHECK(std::popcount(knight_attacks(Square::E4.index())) == 8);
+}
+
+TEST_CASE("Attacks.King", "[attacks]") {
+    CHECK(king_attacks(Square::H8.index()) == bits({Square::G8, Square::G7, Square::H7}));
+}
+
+TEST_CASE("Attacks.Pawn", "[attacks]") {
+    CHECK(pawn_attacks(Color::White, Square::A2.index()) == bits({Square::B3}));
+    CHECK(pawn_attacks(Color::Black, Square::E5.index()) == bits({Square::D4, Square::F4}));
+}
+
+TEST_CASE("Attacks.Sliders", "[attacks]") {
+    const auto occupied = bits({Square::A4, Square::C3});
+    CHECK(rook_attacks(Square::A1.index(), occupied) == bits({Square::A2, Square::A3, Square::A4, Square::B1, Square::C1, Square::D1, Square::E1, Square::F1, Square::G1, Square::H1}));
+    CHECK(bishop_attacks(Square::A1.index(), occupied) == bits({Square::B2, Square::C3}));
+}
+
+TEST_CASE("Attacks.Attackers of a square", "[attacks]") {
+    const BoardBitboards board{Position{FenString{"4k3/8/2p5/3p4/8/8/3R4/3RK3 w - - 0 1"}}};
+    CHECK(board.attackers_to(Square::D5.index(), board.occupied()) == bits({Square::C6, Square::D2}));
+    // Without the rook on d2, the rook on d1 attacks d5.
+    CHECK(board.attackers_to(Square::D5.index(), board.occupied() ^ square_bit(Square::D2.index())) == bits({Square::C6, Square::D1}));
+}
+
+TEST_CASE("Attacks.In check", "[attacks]") {
+    CHECK(is_in_check(Position{FenString{"4k3/8/8/8/8/8/8/4R1K1 b - - 0 1"}}));
+    CHECK_FALSE(is_in_check(Position{FenString{"4k3/8/8/8/4P3/8/8/4R1K1 b - - 0 1"}}));
+    CHECK(is_in_check(Position{FenString{"4k3/8/8/8/8/8/3p4/4K3 w - - 0 1"}}));
+}
@@ -0,0 +1,29 @@
+/* ************************************************************************** *
+ * Chess Engine                                                               *
+ * Chess playing engine                                                       *
+ * ************************************************************************** */
+
+#include <catch2/catch_all.hpp>
+
+#include "chessengine/bench.h"
+
+using namespace chessengine;
+
+TEST_CASE("Bench.Deterministic", "[bench]") {
+    const BenchConfig config{.depth = 2, .hash_size_mb = 1};
+    const auto first = run_bench(config);
+    const auto second = run_bench(config);
+    CHECK(first.positions.size() == bench_positions().size());
+    CHECK(first.nodes > 0);
+    CHECK(first.nodes == second.nodes);
+    for (std::size_t index = 0; index < first.positions.size(); ++index) {
+        CHECK(first.positions[index].nodes == second.positions[index].nodes);
+    }
+}
+
+TEST_CASE("Bench.JSON", "[bench]") {
+    BenchResult result{.depth = 3, .nodes = 42, .elapsed_time = std::chrono::milliseconds{2}};
+    result.positions.push_back(BenchPositionResult{.fen = "8/8/8/8/8/8/8/K6k w - - 0 1", .nodes = 42, .elapsed_time = std::chrono::milliseconds{2}});
+    const std::string expected{R"({"depth":3,"positions":[{"fen":"8/8/8/8/8/8/8/K6k w - - 0 1","nodes":42,"time_ms":2}],"nodes":42,"time_ms":2,"nps":21000})"};
+    CHECK(to_json(result) == expected + '\n');
+}
@@ -0,0 +1,277 @@
+/* ************************************************************************** *
+ * Chess Engine                                                               *
+ * Chess playing engine                                                       *
+ * ************************************************************************** */
+
+#include <catch2/catch_all.hpp>
+
+#include "chessengine/engine_position.h"
+#include "chessengine/evaluation.h"
+
+#include <chesscore/fen.h>
+
+#include <vector>
+
+using namespace chessengine;
+using namespace chesscore;
+
+namespace {
+
+auto find_move(const Position &position, const Square &from, const Square &to, std::optional<PieceType> promotion = std::nullopt) -> Move {
+    for (const auto &move : position.all_legal_moves()) {
+        const auto promoted_type = move.promoted.has_value() ? std::optional<PieceType>{move.promoted.value().type()} : std::nullopt;
+        if (move.from == from && move.to == to && promoted_type == promotion) {
+            return move;
+        }
+    }
+    throw std::runtime_error{"move not found"};
+}
+
+auto play(EnginePosition &position, const Square &from, const Square &to, std::optional<PieceType> promotion = std::nullopt) -> Move {
+    const auto move = find_move(position.position(), from, to, promotion);
+    position.make_move(move);
+    return move;
+}
+
+auto recomputed_key(const EnginePosition &position) -> HashKey {
+    return EnginePosition{position.position()}.key();
+}
+
+} // namespace
+
+TEST_CASE("EnginePosition.Key.Side to move", "[engine_position]") {
+    const EnginePosition white{Position{FenString{"4k3/8/8/8/8/8/8/4K3 w - - 0 1"}}};
+    const EnginePosition black{Position{FenString{"4k3/8/8/8/8/8/8/4K3 b - - 0 1"}}};
+    CHECK(white.key() != black.key());
+}
+
+TEST_CASE("EnginePosition.Key.Castling rights", "[engine_position]") {
+    const EnginePosition all{Position{FenString{"r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1"}}};
+    const EnginePosition some{Position{FenString{"r3k2r/8/8/8/8/8/8/R3K2R w Kq - 0 1"}}};
+    const EnginePosition none{Position{FenString{"r3k2r/8/8/8/8/8/8/R3K2R w - - 0 1"}}};
+    CHECK(all.key() != some.key());
+    CHECK(all.key() != none.key());
+    CHECK(some.key() != none.key());
+}
+
+TEST_CASE("EnginePosition.Key.Quiet moves", "[engine_position]") {
+    EnginePosition position{Position::start_position()};
+    play(position, Square::G1, Square::F3);
+    CHECK(position.key() == recomputed_key(position));
+    play(position, Square::B8, Square::C6);
+    CHECK(position.key() == recomputed_key(position));
+}
+
+TEST_CASE("EnginePosition.Key.Transposition", "[engine_position]") {
+    EnginePosition position1{Position::start_position()};
+    play(position1, Square::G1, Square::F3);
+    play(position1, Square::G8, Square::F6);
+    play(position1, Square::B1, Square::C3);
+
+    EnginePosition position2{Position::start_position()};
+    play(position2, Square::B1, Square::C3);
+    play(position2, Square::G8, Square::F6);
+    play(position2, Square::G1, Square::F3);
+
+    CHECK(position1.key() == position2.key());
+}
+
+TEST_CASE("EnginePosition.Key.Captures and en passant", "[engine_position]") {
+    EnginePosition position{Position{FenString{"rnbqkbnr/ppp1pppp/8/8/3p4/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"}}};
+    play(position, Square::E2, Square::E4);
+    CHECK(position.key() == recomputed_key(position));
+    play(position, Square::D4, Square::E3);
+    CHECK(position.key() == recomputed_key(position));
+    play(position, Square::D2, Square::E3);
+    CHECK(position.key() == recomputed_key(position));
+}
+
+TEST_CASE("EnginePosition.Key.Castling", "[engine_position]") {
+    EnginePosition position{Position{FenString{"r3k2r/pppppppp/8/8/8/8/PPPPPPPP/R3K2R w KQkq - 0 1"}}};
+    play(position, Square::E1, Square::G1);
+    CHECK(position.key() == recomputed_key(position));
+    play(position, Square::E8, Square::C8);
+    CHECK(position.key() == recomputed_key(position));
+}
+
+TEST_CASE("EnginePosition.Key.Rook capture removes castling right", "[engine_position]") {
+    EnginePosition position{Position{FenString{"r3k2r/6P1/8/8/8/8/8/R3K2R w KQkq - 0 1"}}};
+    play(position, Square::G7, Square::H8, PieceType::Queen);
+    CHECK(position.key() == recomputed_key(position));
+}
+
+TEST_CASE("EnginePosition.Key.Unmake restores key", "[engine_position]") {
+    EnginePosition position{Position{FenString{"r3k2r/6P1/8/8/8/8/8/R3K2R w KQkq - 0 1"}}};
+    const auto initial_key = position.key();
+    const auto move1 = play(position, Square::G7, Square::G8, PieceType::Knight);
+    const auto move2 = play(position, Square::E8, Square::D8);
+    position.unmake_move(move2);
+    position.unmake_move(move1);
+    CHECK(position.key() == initial_key);
+    CHECK(position.position() == Position{FenString{"r3k2r/6P1/8/8/8/8/8/R3K2R w KQkq - 0 1"}});
+}
+
+TEST_CASE("EnginePosition.Pawn key", "[engine_position]") {
+    EnginePosition position{Position{FenString{"r3k2r/1P6/8/8/3p4/8/4P3/R3K2R w KQkq - 0 1"}}};
+    const auto recomputed_pawn_key = [&position]() -> HashKey { return EnginePosition{position.position()}.pawn_key(); };
+    const auto initial_pawn_key = position.pawn_key();
+
+    const auto castling = play(position, Square::E1, Square::G1);
+    CHECK(position.pawn_key() == initial_pawn_key);
+    position.unmake_move(castling);
+    play(position, Square::E2, Square::E4);
+    CHECK(position.pawn_key() != initial_pawn_key);
+    CHECK(position.pawn_key() == recomputed_pawn_key());
+    play(position, Square::D4, Square::E3);
+    CHECK(position.pawn_key() == recomputed_pawn_key());
+    play(position, Square::B7, Square::A8, PieceType::Queen);
+    CHECK(position.pawn_key() == recomputed_pawn_key());
+
+    // The other pieces, the side to move and the castling rights do not change the pawn key.
+    const EnginePosition same_pawns{Position{FenString{"4k3/1P6/8/8/3p4/8/4P3/K7 b - - 0 1"}}};
+    CHECK(same_pawns.pawn_key() == initial_pawn_key);
+}
+
+TEST_CASE("EnginePosition.Material key", "[engine_position]") {
+    EnginePosition position{Position{FenString{"r3k2r/1P6/8/8/3p4/8/4P3/R3K2R w KQkq - 0 1"}}};
+    const auto recomputed_material_key = [&position]() -> HashKey { return EnginePosition{position.position()}.material_key(); };
+    const auto initial_material_key = position.material_key();
+    CHECK(initial_material_key == recomputed_material_key());
+
+    // Moves without captures or promotions keep the material.
+    play(position, Square::E2, Square::E4);
+    play(position, Square::E8, Square::G8);
+    CHECK(position.material_key() == initial_material_key);
+    play(position, Square::D4, Square::E3);
+    CHECK(position.material_key() != initial_material_key);
+    CHECK(position.material_key() == recomputed_material_key());
+    play(position, Square::E1, Square::C1);
+    play(position, Square::F8, Square::F7);
+    play(position, Square::B7, Square::A8, PieceType::Queen);
+    CHECK(position.material_key() == recomputed_material_key());
+
+    // The squares of the pieces do not change the material key.
+    const EnginePosition same_material{Position{FenString{"1r2k1r1/8/3p4/8/1P6/8/2P5/1R2K1R1 b - - 0 1"}}};
+    CHECK(same_material.material_key() == EnginePosition{Position{FenString{"r3k2r/1P6/8/8/3p4/8/4P3/R3K2R w KQkq - 0 1"}}}.material_key());
+}
+
+TEST_CASE("EnginePosition.Bitboards", "[engine_position]") {
+    EnginePosition position{Position{FenString{"r3k2r/1P6/8/8/3p4/8/4P3/R3K2R w KQkq - 0 1"}}};
+    play(position, Square::E2, Square::E4);
+    CHECK(position.en_passant_file() == 4);
+    play(position, Square::D4, Square::E3);
+    CHECK(position.board() == BoardBitboards{position.position()});
+    play(position, Square::E1, Square::C1);
+    CHECK(position.board() == BoardBitboards{position.position()});
+    play(position, Square::E8, Square::G8);
+    CHECK(position.castling_rights() == 0);
+    const auto promotion = play(position, Square::B7, Square::A8, PieceType::Queen);
+    CHECK(position.board() == BoardBitboards{position.position()});
+    position.unmake_move(promotion);
+    CHECK(position.board() == BoardBitboards{position.position()});
+}
+
+TEST_CASE("EnginePosition.Evaluation terms", "[engine_position]") {
+    const Evaluator evaluator{};
+    EnginePosition position{Position{FenString{"r3k2r/1P6/8/8/3p4/8/4P3/R3K2R w KQkq - 0 1"}}};
+    position.set_piece_square_values(&evaluator.piece_square_values());
+    const auto initial_terms = position.evaluation_terms();
+    const auto matches_full_evaluation = [&evaluator, &position]() -> bool {
+        const auto pawns = evaluator.pawn_entry(position.board());
+        const auto material = evaluator.material_entry(position.board());
+        return evaluator.static_evaluation(position, pawns, material, Color::White) == evaluator.static_evaluation(position.position(), Color::White) &&
+               evaluator.static_evaluation(position, pawns, material, Color::Black) == evaluator.static_evaluation(position.position(), Color::Black);
+    };
+    CHECK(matches_full_evaluation());
+
+    std::vector<Move> moves;
+    moves.push_back(play(position, Square::E2, Square::E4));
+    moves.push_back(play(position, Square::D4, Square::E3));
+    CHECK(matches_full_evaluation());
+    moves.push_back(play(position, Square::E1, Square::C1));
+    moves.push_back(play(position, Square::E8, Square::G8));
+    CHECK(matches_full_evaluation());
+    moves.push_back(play(position, Square::B7, Square::A8, PieceType::Queen));
+    CHECK(matches_full_evaluation());
+    for (auto it = moves.rbegin(); it != moves.rend(); ++it) {
+        position.unmake_move(*it);
+    }
+    CHECK(position.evaluation_terms() == initial_terms);
+}
+
+TEST_CASE("EnginePosition.MoveScope", "[engine_position]") {
+    EnginePosition position{Position::start_position()};
+    const auto initial_key = position.key();
+    const auto move = find_move(position.position(), Square::E2, Square::E4);
+    {
+        MoveScope scope{position, move};
+        CHECK(position.key() != initial_key);
+        CHECK(position.side_to_move() == Color::Black);
+    }
+    CHECK(position.key() == initial_key);
+    CHECK(position.side_to_move() == Color::White);
+}
+
+TEST_CASE("EnginePosition.Null move", "[engine_position]") {
+    EnginePosition position{Position{FenString{"4k3/8/8/3pP3/8/8/8/4K3 w - d6 0 2"}}};
+    const auto initial_key = position.key();
+    {
+        NullMoveScope scope{position};
+        CHECK(position.in_null_move());
+        CHECK(position.side_to_move() == Color::Black);
+        CHECK(position.key() != initial_key);
+        CHECK(position.key() == EnginePosition{Position{FenString{"4k3/8/8/3pP3/8/8/8/4K3 b - - 0 2"}}}.key());
+
+        // Moves after the null move only change the engine state.
+        const Move king_move{.from = Square::E8, .to = Square::D8, .piece = Piece::BlackKing};
+        MoveScope move_scope{position, king_move};
+        const EnginePosition expected{Position{FenString{"3k4/8/8/3pP3/8/8/8/4K3 w - - 1 3"}}};
+        CHECK(position.side_to_move() == Color::White);
+        CHECK(position.key() == expected.key());
+        CHECK(position.board() == expected.board());
+    }
+    CHECK_FALSE(position.in_null_move());
+    CHECK(position.key() == initial_key);
+    CHECK(position.side_to_move() == Color::White);
+    CHECK(position.position() == Position{FenString{"4k3/8/8/3pP3/8/8/8/4K3 w - d6 0 2"}});
+}
+
+TEST_CASE("EnginePosition.Repetition", "[engine_position]") {
+    EnginePosition position{Position::start_position()};
+    play(position, Square::G1, Square::F3);
+    play(position, Square::G8, Square::F6);
+    play(position, Square::F3, Square::G1);
+    CHECK_FALSE(position.is_repetition());
+    play(position, Square::F6, Square::G8);
+    CHECK(position.is_repetition());
+    CHECK(position.is_draw());
+}
+
+TEST_CASE("EnginePosition.Repetition.Not across irreversible moves", "[engine_position]") {
+    EnginePosition position{Position::start_position()};
+    play(position, Square::G1, Square::F3);
+    position.make_null_move();
+    play(position, Square::F3, Square::G1);
+    position.make_null_move();
+    CHECK(position.key() == EnginePosition{Position::start_position()}.key());
+    CHECK_FALSE(position.is_repetition());
+}
+
+TEST_CASE("EnginePosition.Fifty-move rule", "[engine_position]") {
+    EnginePosition position{Position{FenString{"4k3/8/8/8/8/8/8/R3K3 w - - 99 80"}}};
+    CHECK(position.halfmove_clock() == 99);
+    CHECK_FALSE(position.is_draw());
+    const auto move = play(position, Square::A1, Square::A2);
+    CHECK(position.halfmove_clock() == 100);
+    CHECK(position.is_draw());
+    position.unmake_move(move);
+    CHECK(position.halfmove_clock() == 99);
+    play(position, Square::E1, Square::E2);
+    CHECK(position.is_draw());
+}
+
+TEST_CASE("EnginePosition.Fifty-move rule.Mate takes precedence", "[engine_position]") {
+    EnginePosition position{Position{FenString{"7k/R7/8/8/8/8/8/1R2K3 w - - 99 80"}}};
+    play(position, Square::B1, Square::B8);
+    CHECK_FALSE(position.is_draw());
+}
@@ -0,0 +1,53 @@
+/* ************************************************************************** *
+ * Chess Engine                                                               *
+ * Chess playing engine                                                       *
+ * ************************************************************************** */
+
+#include <catch2/catch_all.hpp>
+
+#include "chessengine/eval_cache.h"
+
+using namespace chessengine;
+
+TEST_CASE("EvalCache.Store and probe", "[eval_cache]") {
+    EvalCache cache{1};
+    const HashKey key{0x123456789ABCDEF0ULL};
+    CHECK_FALSE(cache.probe(key).has_value());
+
+    cache.store(key, Score{-317});
+    REQUIRE(cache.probe(key).has_value());
+    CHECK(cache.probe(key).value() == Score{-317});
+    cache.store(key, Score{42});
+    CHECK(cache.probe(key).value() == Score{42});
+}
+
+TEST_CASE("EvalCache.Key mismatch", "[eval_cache]") {
+    EvalCache cache{1};
+    const HashKey key{0x123456789ABCDEF0ULL};
+    cache.store(key, Score{25});
+
+    // Same slot, but different upper key bits.
+    CHECK_FALSE(cache.probe(key ^ 0x8000000000000000ULL).has_value());
+    cache.store(key ^ 0x8000000000000000ULL, Score{-5});
+    CHECK_FALSE(cache.probe(key).has_value());
+}
+
+TEST_CASE("EvalCache.Clear and resize", "[eval_cache]") {
+    EvalCache cache{1};
+    const HashKey key{0xFEDCBA9876543210ULL};
+    cache.store(key, Score{100});
+    cache.clear();
+    CHECK_FALSE(cache.probe(key).has_value());
+
+    cache.store(key, Score{100});
+    cache.resize(2);
+    CHECK(cache.size_mb() == 2);
+    CHECK_FALSE(cache.probe(key).has_value());
+    cache.resize(0);
+    CHECK(cache.size_mb() == 0);
+    CHECK(cache.empty());
+    cache.clear();
+    cache.resize(1);
+    CHECK_FALSE(cache.empty());
+    CHECK_FALSE(cache.probe(key).has_value());
+}
@@ -6,11 +6,18 @@
 #include <catch2/catch_all.hpp>
 
 #include "chessengine/evaluation.h"
+
+#include <algorithm>
+#include <cctype>
+#include <string>
+#include <vector>
+
 using namespace chessengine;
 using namespace chesscore;
 
 namespace {
 auto get_default_config() -> EvaluatorConfig;
+auto mirrored_fen(const std::string &fen) -> std::string;
 }
 
 TEST_CASE("Evaluation.White mated", "[evaluation]") {
@@ -27,6 +34,14 @@ TEST_CASE("Evaluation.Black mated", "[evaluation]") {
     CHECK(evaluator.evaluate(position, Color::Black) == -Score::Mate);
 }
 
+TEST_CASE("Evaluation.Stalemate", "[evaluation]") {
+    const Evaluator evaluator{};
+    const Position position{FenString{"k7/8/1QK5/8/8/8/8/8 b - - 0 1"}};
+    CHECK(evaluator.evaluate(position, Color::White) == Score{0});
+    CHECK(evaluator.evaluate(position, Color::Black) == Score{0});
+    CHECK(evaluator.static_evaluation(position, Color::White) > Score{0});
+}
+
 TEST_CASE("Evaluation.Material.Piece Values", "[evaluation]") {
     EvaluatorConfig config = get_default_config();
 
@@ -60,8 +75,185 @@ TEST_CASE("Evaluation.Pieces on Squares", "[evaluation]") {
     CHECK(evaluator.evaluate_pieces_on_squares(position2, Color::Black) == Score{20 + 30 - 5 + 15 - 20 - 50});
 }
 
+TEST_CASE("Evaluation.Game phase", "[evaluation]") {
+    const Evaluator evaluator{};
+
+    CHECK(evaluator.game_phase(Position::start_position()) == EvaluatorConfig::max_game_phase);
+    CHECK(evaluator.game_phase(Position{FenString{"4k3/8/8/8/8/8/4P3/4K3 w - - 0 1"}}) == 0);
+    CHECK(evaluator.game_phase(Position{FenString{"3qk3/8/8/8/8/8/4P3/1N2K2R w - - 0 1"}}) == 4 + 1 + 2);
+    CHECK(evaluator.game_phase(Position{FenString{"QQQQkQQQ/8/8/8/8/8/8/4K3 w - - 0 1"}}) == EvaluatorConfig::max_game_phase);
+}
+
+TEST_CASE("Evaluation.Tapered", "[evaluation]") {
+    CHECK(EvaluatorConfig::tapered(Score{100}, Score{-20}, EvaluatorConfig::max_game_phase) == Score{100});
+    CHECK(EvaluatorConfig::tapered(Score{100}, Score{-20}, 0) == Score{-20});
+    CHECK(EvaluatorConfig::tapered(Score{100}, Score{-20}, EvaluatorConfig::max_game_phase / 2) == Score{40});
+    CHECK(EvaluatorConfig::tapered(Score{100}, Score{-20}, EvaluatorConfig::max_game_phase + 6) == Score{100});
+}
+
+TEST_CASE("Evaluation.Endgame king", "[evaluation]") {
+    const Evaluator evaluator{};
+    const Position central_king{FenString{"4k3/8/8/8/3K4/8/4P3/8 w - - 0 1"}};
+    const Position corner_king{FenString{"4k3/8/8/8/8/8/4P3/K7 w - - 0 1"}};
+
+    CHECK(evaluator.static_evaluation(central_king, Color::White) > evaluator.static_evaluation(corner_king, Color::White));
+}
+
+TEST_CASE("Evaluation.Pawn structure.Doubled and isolated pawns", "[evaluation]") {
+    const Evaluator evaluator{};
+    const EvaluatorConfig config{};
+    const auto entry = evaluator.pawn_entry(BoardBitboards{Position{FenString{"4k3/8/8/8/8/4P3/4P3/4K3 w - - 0 1"}}});
+
+    CHECK(entry.middlegame == config.doubled_pawn.middlegame + 2 * config.isolated_pawn.middlegame + config.passed_pawn[2].middlegame);
+    CHECK(entry.endgame == config.doubled_pawn.endgame + 2 * config.isolated_pawn.endgame + config.passed_pawn[2].endgame);
+    CHECK(entry.passed_pawns[0] == square_bit(Square::E3.index()));
+    CHECK(entry.passed_pawns[1] == 0);
+    CHECK(entry.king_shelter == 2 * config.king_shelter_pawn);
+}
+
+TEST_CASE("Evaluation.Pawn structure.Backward and passed pawns", "[evaluation]") {
+    const Evaluator evaluator{};
+    const EvaluatorConfig config{};
+    const auto entry = evaluator.pawn_entry(BoardBitboards{Position{FenString{"4k3/8/8/4p3/2P5/3P4/8/4K3 w - - 0 1"}}});
+
+    CHECK(entry.middlegame == config.backward_pawn.middlegame + config.passed_pawn[3].middlegame - config.isolated_pawn.middlegame);
+    CHECK(entry.endgame == config.backward_pawn.endgame + config.passed_pawn[3].endgame - config.isolated_pawn.endgame);
+    CHECK(entry.passed_pawns[0] == square_bit(Square::C4.index()));
+    CHECK(entry.passed_pawns[1] == 0);
+}
+
+TEST_CASE("Evaluation.Pawn structure.King shelter", "[evaluation]") {
+    const Evaluator evaluator{};
+    const EvaluatorConfig config{};
+    const BoardBitboards castled{Position{FenString{"6k1/5ppp/8/8/8/8/5PPP/6K1 w - - 0 1"}}};
+    const BoardBitboards moved_out{Position{FenString{"6k1/5ppp/8/8/8/8/5PPP/3K4 w - - 0 1"}}};
+    auto entry = evaluator.pawn_entry(castled);
+    CHECK(entry.king_shelter == Score{0});
+
+    evaluator.evaluate_king_shelter(moved_out, entry);
+    CHECK(entry.king_shelter == -3 * config.king_shelter_pawn);
+    CHECK(entry.king_squares[0] == Square::D1.index());
+    CHECK(entry.middlegame == evaluator.pawn_entry(moved_out).middlegame);
+}
+
+TEST_CASE("Evaluation.Material.Phase", "[evaluation]") {
+    const Evaluator evaluator{};
+    for (const auto *fen : {"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", "3qk3/8/8/8/8/8/4P3/1N2K2R w - - 0 1", "QQQQkQQQ/8/8/8/8/8/8/4K3 w - - 0 1"}) {
+        const Position position{FenString{fen}};
+        CHECK(evaluator.material_entry(BoardBitboards{position}).phase == evaluator.game_phase(position));
+    }
+}
+
+TEST_CASE("Evaluation.Material.Imbalance", "[evaluation]") {
+    const Evaluator evaluator{};
+    const EvaluatorConfig config{};
+    const auto bishop_pair = evaluator.material_entry(BoardBitboards{Position{FenString{"2b1kb2/ppppp3/8/8/8/8/PPPPP3/2B1KN2 w - - 0 1"}}});
+    CHECK(bishop_pair.imbalance.middlegame == -config.bishop_pair.middlegame);
+    CHECK(bishop_pair.imbalance.endgame == -config.bishop_pair.endgame);
+
+    const auto knight_and_rook = evaluator.material_entry(BoardBitboards{Position{FenString{"3rk3/pppppppp/8/8/8/8/PPPPPPPP/3NK3 w - - 0 1"}}});
+    CHECK(knight_and_rook.imbalance.middlegame == 3 * config.knight_pawn_adjustment - 3 * config.rook_pawn_adjustment);
+}
+
+TEST_CASE("Evaluation.Material.Insufficient material", "[evaluation]") {
+    const Evaluator evaluator{};
+    CHECK(evaluator.material_entry(BoardBitboards{Position{FenString{"4k3/8/8/8/8/8/8/4K3 w - - 0 1"}}}).draw);
+    CHECK(evaluator.material_entry(BoardBitboards{Position{FenString{"4k3/8/8/8/8/8/8/2N1K3 w - - 0 1"}}}).draw);
+    CHECK_FALSE(evaluator.material_entry(BoardBitboards{Position{FenString{"4k3/8/8/8/8/8/8/2NNK3 w - - 0 1"}}}).draw);
+    CHECK_FALSE(evaluator.material_entry(BoardBitboards{Position{FenString{"4k3/8/8/8/8/8/4P3/4K3 w - - 0 1"}}}).draw);
+    CHECK(evaluator.static_evaluation(Position{FenString{"4k3/8/8/8/8/8/8/1B2K3 w - - 0 1"}}, Color::White) == Score{0});
+
+    // Two knights cannot force a checkmate, a rook against a minor piece is hard to win.
+    const auto two_knights = evaluator.material_entry(BoardBitboards{Position{FenString{"4k3/8/8/8/8/8/8/2NNK3 w - - 0 1"}}});
+    CHECK(two_knights.scale[0] == 0);
+    const auto rook_against_bishop = evaluator.material_entry(BoardBitboards{Position{FenString{"4kb2/8/8/8/8/8/8/R3K3 w - - 0 1"}}});
+    CHECK(rook_against_bishop.scale[0] == MaterialEntry::drawish_scale);
+    CHECK(rook_against_bishop.scale[1] == 0);
+}
+
+TEST_CASE("Evaluation.Material.Mating drive", "[evaluation]") {
+    const Evaluator evaluator{};
+    const Position centralized{FenString{"8/8/8/3k4/8/8/8/R3K3 w - - 0 1"}};
+    const Position cornered{FenString{"k7/8/1K6/8/8/8/8/R7 w - - 0 1"}};
+    const auto entry = evaluator.material_entry(BoardBitboards{centralized});
+
+    CHECK(entry.endgame != nullptr);
+    CHECK(entry.strong_side == Color::White);
+    CHECK(evaluator.static_evaluation(cornered, Color::White) > evaluator.static_evaluation(centralized, Color::White));
+    CHECK(evaluator.static_evaluation(cornered, Color::Black) == -evaluator.static_evaluation(cornered, Color::White));
+}
+
+TEST_CASE("Evaluation.Pawn structure.Replaced entry", "[evaluation]") {
+    const Evaluator evaluator{};
+    const EnginePosition sheltered{Position{FenString{"6k1/ppp5/8/8/8/8/5PPP/6K1 w - - 0 1"}}};
+    const EnginePosition exposed{Position{FenString{"6k1/5ppp/8/8/8/8/PPP5/6K1 w - - 0 1"}}};
+    REQUIRE(sheltered.pawn_key() != exposed.pawn_key());
+    PawnHashTable table{1};
+    auto &entry = table.entry(sheltered.pawn_key());
+
+    CHECK_FALSE(evaluator.update_pawn_entry(sheltered.board(), sheltered.pawn_key(), entry));
+    CHECK(evaluator.update_pawn_entry(sheltered.board(), sheltered.pawn_key(), entry));
+    CHECK(entry.king_shelter > Score{0});
+
+    // Same king squares, but other pawns in the same slot.
+    CHECK_FALSE(evaluator.update_pawn_entry(exposed.board(), exposed.pawn_key(), entry));
+    const auto expected = evaluator.pawn_entry(exposed.board());
+    CHECK(entry.key == exposed.pawn_key());
+    CHECK(entry.king_shelter == expected.king_shelter);
+    CHECK(entry.king_shelter < Score{0});
+    CHECK(entry.middlegame == expected.middlegame);
+    CHECK(entry.endgame == expected.endgame);
+}
+
+TEST_CASE("Evaluation.Symmetry", "[evaluation]") {
+    const Evaluator evaluator{};
+    const std::vector<std::string> fens{
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "4rrk1/pp1n3p/3q2pQ/2p1pb2/2PP4/2P3N1/P2B2PP/4RRK1 b - - 7 19",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 11",
+        "4k3/8/8/8/3K4/8/4P3/8 w - - 0 1",
+    };
+    for (const auto &fen : fens) {
+        INFO(fen);
+        const Position position{FenString{fen}};
+        const Position mirrored{FenString{mirrored_fen(fen)}};
+
+        CHECK(evaluator.static_evaluation(position, Color::White) == -evaluator.static_evaluation(position, Color::Black));
+        CHECK(evaluator.static_evaluation(position, Color::White) == evaluator.static_evaluation(mirrored, Color::Black));
+        CHECK(evaluator.static_evaluation(position, Color::Black) == evaluator.static_evaluation(mirrored, Color::White));
+    }
+}
+
 namespace {
 
+auto mirrored_fen(const std::string &fen) -> std::string {
+    // Flip the board vertically and swap the colors.
+    const auto board_end = fen.find(' ');
+    std::string board;
+    for (std::size_t rank_end = board_end; rank_end != std::string::npos && rank_end > 0;) {
+        const auto rank_begin = fen.rfind('/', rank_end - 1);
+        const auto begin = rank_begin == std::string::npos ? 0 : rank_begin + 1;
+        board += (board.empty() ? "" : "/") + fen.substr(begin, rank_end - begin);
+        rank_end = rank_begin;
+    }
+    const auto swap_case = [](char c) -> char { return std::isupper(c) != 0 ? static_cast<char>(std::tolower(c)) : static_cast<char>(std::toupper(c)); };
+    std::ranges::transform(board, board.begin(), swap_case);
+
+    const auto side_begin = board_end + 1;
+    const auto castling_begin = side_begin + 2;
+    const auto castling_end = fen.find(' ', castling_begin);
+    std::string castling = fen.substr(castling_begin, castling_end - castling_begin);
+    std::ranges::transform(castling, castling.begin(), swap_case);
+    std::ranges::stable_sort(castling, [](char lhs, char rhs) -> bool { return (std::isupper(lhs) != 0) > (std::isupper(rhs) != 0); });
+    std::string en_passant = fen.substr(castling_end + 1, fen.find(' ', castling_end + 1) - castling_end - 1);
+    if (en_passant != "-") {
+        en_passant[1] = en_passant[1] == '3' ? '6' : '3';
+    }
+    const auto clocks = fen.substr(fen.find(' ', castling_end + 1));
+    return board + (fen[side_begin] == 'w' ? " b " : " w ") + castling + " " + en_passant + clocks;
+}
+
 auto get_default_config() -> EvaluatorConfig {
     return EvaluatorConfig{
         .piece_values = {Score{100}, Score{300}, Score{300}, Score{500}, Score{900}, Score{0}},
@@ -95,12 +287,7 @@ auto get_default_config() -> EvaluatorConfig {
              Score{0},   Score{20},  Score{20},  Score{-10}, Score{-20}, Score{-20}, Score{-20}, Score{-20}, Score{-20}, Score{-20}, Score{-10}, Score{-20}, Score{-30},
              Score{-30}, Score{-40}, Score{-40}, Score{-30}, Score{-30}, Score{-20}, Score{-30}, Score{-40}, Score{-40}, Score{-50}, Score{-50}, Score{-40}, Score{-40},
              Score{-30}, Score{-30}, Score{-40}, Score{-40}, Score{-50}, Score{-50}, Score{-40}, Score{-40}, Score{-30}, Score{-30}, Score{-40}, Score{-40}, Score{-50},
-             Score{-50}, Score{-40}, Score{-40}, Score{-30}, Score{-30}, Score{-40}, Score{-40}, Score{-50}, Score{-50}, Score{-40}, Score{-40}, Score{-30}},
-            {Score{-50}, Score{-30}, Score{-30}, Score{-30}, Score{-30}, Score{-30}, Score{-30}, Score{-50}, Score{-30}, Score{-30}, Score{0},   Score{0},   Score{0},
-             Score{0},   Score{-30}, Score{-30}, Score{-30}, Score{-10}, Score{20},  Score{30},  Score{30},  Score{20},  Score{-10}, Score{-30}, Score{-30}, Score{-10},
-             Score{30},  Score{40},  Score{40},  Score{30},  Score{-10}, Score{-30}, Score{-30}, Score{-10}, Score{30},  Score{40},  Score{40},  Score{30},  Score{-10},
-             Score{-30}, Score{-30}, Score{-10}, Score{20},  Score{30},  Score{30},  Score{20},  Score{-10}, Score{-30}, Score{-30}, Score{-20}, Score{-10}, Score{0},
-             Score{0},   Score{-10}, Score{-20}, Score{-30}, Score{-50}, Score{-40}, Score{-30}, Score{-20}, Score{-20}, Score{-30}, Score{-40}, Score{-50}}
+             Score{-50}, Score{-40}, Score{-40}, Score{-30}, Score{-30}, Score{-40}, Score{-40}, Score{-50}, Score{-50}, Score{-40}, Score{-40}, Score{-30}}
         }
     };
 }
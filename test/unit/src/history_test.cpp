@@ -0,0 +1,73 @@
+/* ************************************************************************** *
+ * Chess Engine                                                               *
+ * Chess playing engine                                                       *
+ * ************************************************************************** */
+
+#include <catch2/catch_all.hpp>
+
+#include "chessengine/history.h"
+#include "chessengine/search_stack.h"
+
+using namespace chessengine;
+using namespace chesscore;
+
+TEST_CASE("HistoryTable.Bonus and malus", "[history]") {
+    const Move move{.from = Square::G1, .to = Square::F3, .piece = Piece::WhiteKnight};
+
+    HistoryTable history;
+    CHECK(history.value(Color::White, move) == 0);
+    history.update(Color::White, move, HistoryTable::bonus(Depth{4}));
+    CHECK(history.value(Color::White, move) > 0);
+    CHECK(history.value(Color::Black, move) == 0);
+    history.update(Color::White, move, -2 * HistoryTable::bonus(Depth{4}));
+    CHECK(history.value(Color::White, move) < 0);
+    history.clear();
+    CHECK(history.value(Color::White, move) == 0);
+}
+
+TEST_CASE("HistoryTable.Gravity limits values", "[history]") {
+    const Move move{.from = Square::E2, .to = Square::E4, .piece = Piece::WhitePawn};
+
+    HistoryTable history;
+    for (int i = 0; i < 1000; ++i) {
+        history.update(Color::White, move, HistoryTable::bonus(Depth{20}));
+    }
+    CHECK(history.value(Color::White, move) <= HistoryTable::max_value);
+    CHECK(history.value(Color::White, move) > HistoryTable::max_value / 2);
+    for (int i = 0; i < 1000; ++i) {
+        history.update(Color::White, move, -HistoryTable::bonus(Depth{20}));
+    }
+    CHECK(history.value(Color::White, move) >= -HistoryTable::max_value);
+    CHECK(history.value(Color::White, move) < -HistoryTable::max_value / 2);
+}
+
+TEST_CASE("CountermoveTable.Store refutation", "[history]") {
+    const Move move{.from = Square::E2, .to = Square::E4, .piece = Piece::WhitePawn};
+    const Move reply{.from = Square::D7, .to = Square::D5, .piece = Piece::BlackPawn};
+
+    CountermoveTable countermoves;
+    CHECK_FALSE(countermoves.get(move).matches(reply));
+    countermoves.set(move, reply);
+    CHECK(countermoves.get(move).matches(reply));
+}
+
+TEST_CASE("SearchStack.Killer moves", "[history]") {
+    const Move move1{.from = Square::G1, .to = Square::F3, .piece = Piece::WhiteKnight};
+    const Move move2{.from = Square::B1, .to = Square::C3, .piece = Piece::WhiteKnight};
+    const Move move3{.from = Square::E2, .to = Square::E4, .piece = Piece::WhitePawn};
+
+    SearchStack stack;
+    stack[3].add_killer(move1);
+    stack[3].add_killer(move1);
+    CHECK(stack[3].killers[0].matches(move1));
+    CHECK_FALSE(stack[3].killers[1].matches(move1));
+    stack[3].add_killer(move2);
+    stack[3].add_killer(move3);
+    CHECK(stack[3].killers[0].matches(move3));
+    CHECK(stack[3].killers[1].matches(move2));
+
+    CHECK_FALSE(stack.previous_move(0).has_value());
+    stack[0].current_move = move1;
+    REQUIRE(stack.previous_move(1).has_value());
+    CHECK(stack.previous_move(1).value() == move1);
+}
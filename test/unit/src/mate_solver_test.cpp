@@ -0,0 +1,47 @@
+/* ************************************************************************** *
+ * Chess Engine                                                               *
+ * Chess playing engine                                                       *
+ * ************************************************************************** */
+
+#include <catch2/catch_all.hpp>
+
+#include "chessengine/mate_solver.h"
+
+#include <chesscore/fen.h>
+
+using namespace chessengine;
+using namespace chesscore;
+
+namespace {
+
+auto solve(const std::string &fen, int moves) -> SearchStats {
+    const std::atomic<bool> stop_requested{false};
+    MateSolver solver{stop_requested, 1};
+    EnginePosition position{Position{FenString{fen}}};
+    return solver.solve(position, moves, StopParameters{}, std::chrono::steady_clock::now());
+}
+
+} // namespace
+
+TEST_CASE("MateSolver.Mate in one", "[mate_solver]") {
+    const auto result = solve("6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1", 1);
+    REQUIRE(is_winning_score(result.best_move.score));
+    CHECK(ply_to_mate(result.best_move.score) == Depth{1});
+    CHECK(result.best_move.move.from == Square::A1);
+    CHECK(result.best_move.move.to == Square::A8);
+    CHECK(result.best_move.pv.size() == 1);
+}
+
+TEST_CASE("MateSolver.Shortest mate is found", "[mate_solver]") {
+    const auto result = solve("7k/8/8/8/8/8/R7/1R4K1 w - - 0 1", 3);
+    REQUIRE(is_winning_score(result.best_move.score));
+    CHECK(ply_to_mate(result.best_move.score) == Depth{3});
+    CHECK(result.best_move.pv.size() == 3);
+    CHECK((result.best_move.move.to == Square::A7 || result.best_move.move.to == Square::B7));
+}
+
+TEST_CASE("MateSolver.No mate", "[mate_solver]") {
+    const auto result = solve("4k3/8/8/8/8/8/8/4K3 w - - 0 1", 2);
+    CHECK_FALSE(is_winning_score(result.best_move.score));
+    CHECK(result.nodes > 0);
+}
@@ -0,0 +1,39 @@
+/* ************************************************************************** *
+ * Chess Engine                                                               *
+ * Chess playing engine                                                       *
+ * ************************************************************************** */
+
+#include <catch2/catch_all.hpp>
+
+#include "chessengine/material_hash_table.h"
+
+using namespace chessengine;
+
+TEST_CASE("MaterialHashTable.Entry", "[material_hash_table]") {
+    MaterialHashTable table{256};
+    const HashKey key{0x0FEDCBA987654321ULL};
+    auto &entry = table.entry(key);
+    CHECK(entry.key == 0);
+    CHECK(entry.endgame == nullptr);
+    CHECK(entry.scale[0] == MaterialEntry::full_scale);
+    CHECK(entry.scale[1] == MaterialEntry::full_scale);
+
+    entry.key = key;
+    entry.phase = 12;
+    entry.draw = true;
+    CHECK(table.entry(key).key == key);
+    CHECK(table.entry(key).phase == 12);
+    CHECK(table.entry(key).draw);
+    CHECK(&table.entry(key + 256) == &entry);
+    CHECK(&table.entry(key + 1) != &entry);
+}
+
+TEST_CASE("MaterialHashTable.Clear", "[material_hash_table]") {
+    MaterialHashTable table{16};
+    const HashKey key{42};
+    table.entry(key).key = key;
+    table.entry(key).draw = true;
+    table.clear();
+    CHECK(table.entry(key).key == 0);
+    CHECK_FALSE(table.entry(key).draw);
+}
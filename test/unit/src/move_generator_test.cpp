@@ -0,0 +1,147 @@
+/* ************************************************************************** *
+ * Chess Engine                                                               *
+ * Chess playing engine                                                       *
+ * ************************************************************************** */
+
+#include <catch2/catch_all.hpp>
+
+#include "chessengine/move_generator.h"
+
+#include <chesscore/fen.h>
+
+#include <algorithm>
+#include <string>
+
+using namespace chessengine;
+using namespace chesscore;
+
+namespace {
+
+auto perft(EnginePosition &position, int depth) -> std::uint64_t {
+    const MoveGenerator generator{position};
+    GeneratedMoves moves;
+    generator.generate_moves(moves);
+    std::uint64_t nodes{0};
+    for (const auto &move : moves) {
+        if (!generator.is_legal(move)) {
+            continue;
+        }
+        if (depth == 1) {
+            ++nodes;
+        } else {
+            MoveScope scope{position, move};
+            nodes += perft(position, depth - 1);
+        }
+    }
+    return nodes;
+}
+
+auto perft(const std::string &fen, int depth) -> std::uint64_t {
+    EnginePosition position{Position{FenString{fen}}};
+    return perft(position, depth);
+}
+
+auto legal_moves(const MoveGenerator &generator) -> GeneratedMoves {
+    GeneratedMoves moves;
+    generator.generate_legal_moves(moves);
+    return moves;
+}
+
+/**
+ * \brief Compare the legal moves with those of chesscore in all positions up to a depth.
+ */
+auto matches_chesscore(EnginePosition &position, int depth) -> bool {
+    const auto moves = legal_moves(MoveGenerator{position});
+    const auto reference = position.position().all_legal_moves();
+    if (moves.size() != reference.size()) {
+        return false;
+    }
+    for (const auto &move : moves) {
+        const auto found = std::ranges::any_of(reference, [&move](const Move &reference_move) -> bool {
+            return reference_move.from == move.from && reference_move.to == move.to && reference_move.piece == move.piece && reference_move.captured == move.captured &&
+                   reference_move.promoted == move.promoted;
+        });
+        if (!found) {
+            return false;
+        }
+        if (depth > 1) {
+            MoveScope scope{position, move};
+            if (!matches_chesscore(position, depth - 1)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+TEST_CASE("MoveGenerator.Perft", "[move_generator]") {
+    CHECK(perft("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 3) == 8902);
+    CHECK(perft("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 2) == 2039);
+    CHECK(perft("8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", 4) == 43238);
+    CHECK(perft("r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", 3) == 9467);
+    CHECK(perft("rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8", 3) == 62379);
+    CHECK(perft("r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10", 3) == 89890);
+}
+
+TEST_CASE("MoveGenerator.Matches chesscore", "[move_generator]") {
+    for (const auto *fen : {"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1"}) {
+        EnginePosition position{Position{FenString{fen}}};
+        CHECK(matches_chesscore(position, 2));
+    }
+}
+
+TEST_CASE("MoveGenerator.Captures and quiets", "[move_generator]") {
+    const EnginePosition position{Position{FenString{"4k3/1P6/8/3p4/4P3/8/8/4K3 w - - 0 1"}}};
+    const MoveGenerator generator{position};
+    GeneratedMoves captures;
+    generator.generate_captures(captures);
+    GeneratedMoves quiets;
+    generator.generate_quiets(quiets);
+
+    // exd5 and the four promotions on b8
+    CHECK(captures.size() == 5);
+    CHECK(std::ranges::all_of(captures, [](const Move &move) -> bool { return move.is_capture() || move.is_pawn_promotion(); }));
+    CHECK(std::ranges::none_of(quiets, [](const Move &move) -> bool { return move.is_capture() || move.is_pawn_promotion(); }));
+    CHECK(captures.size() + quiets.size() == legal_moves(generator).size());
+}
+
+TEST_CASE("MoveGenerator.Evasions", "[move_generator]") {
+    const EnginePosition position{Position{FenString{"4k3/4r3/8/8/1b6/8/3N4/4K2R w K - 0 1"}}};
+    const MoveGenerator generator{position};
+    REQUIRE(generator.in_check());
+    GeneratedMoves evasions;
+    generator.generate_evasions(evasions);
+    std::size_t legal_evasions{0};
+    for (const auto &move : evasions) {
+        legal_evasions += generator.is_legal(move) ? 1 : 0;
+    }
+    // No castling out of check. The knight is pinned and cannot block on e4, so only the king moves to d1, f1 and f2.
+    CHECK(legal_evasions == 3);
+    CHECK(legal_evasions == position.position().all_legal_moves().size());
+    CHECK(std::ranges::none_of(evasions, [](const Move &move) -> bool { return move.to == Square::G1; }));
+}
+
+TEST_CASE("MoveGenerator.Pinned piece", "[move_generator]") {
+    const EnginePosition position{Position{FenString{"4k3/4r3/8/8/8/8/4R3/4K3 w - - 0 1"}}};
+    const MoveGenerator generator{position};
+    const auto moves = legal_moves(generator);
+    // The rook can only move along the e-file.
+    CHECK(std::ranges::all_of(moves, [](const Move &move) -> bool { return move.piece.type() != PieceType::Rook || move.to.index() % 8 == 4; }));
+    CHECK(moves.size() == position.position().all_legal_moves().size());
+}
+
+TEST_CASE("MoveGenerator.En passant discovered check", "[move_generator]") {
+    // Capturing en passant would remove both pawns from the fifth rank and expose the king to the rook.
+    const EnginePosition position{Position{FenString{"8/8/8/K2pP2r/8/8/8/7k w - d6 0 1"}}};
+    const MoveGenerator generator{position};
+    const auto moves = legal_moves(generator);
+    CHECK(std::ranges::none_of(moves, [](const Move &move) -> bool { return move.to == Square::D6; }));
+}
+
+TEST_CASE("MoveGenerator.Has legal moves", "[move_generator]") {
+    CHECK(MoveGenerator{EnginePosition{Position::start_position()}}.has_legal_moves());
+    CHECK_FALSE(MoveGenerator{EnginePosition{Position{FenString{"7k/5Q2/6K1/8/8/8/8/8 b - - 0 1"}}}}.has_legal_moves());
+    CHECK_FALSE(MoveGenerator{EnginePosition{Position{FenString{"R5k1/5ppp/8/8/8/8/8/6K1 b - - 0 1"}}}}.has_legal_moves());
+}
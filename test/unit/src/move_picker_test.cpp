@@ -0,0 +1,97 @@
+/* ************************************************************************** *
+ * Chess Engine                                                               *
+ * Chess playing engine                                                       *
+ * ************************************************************************** */
+
+#include <catch2/catch_all.hpp>
+
+#include "chessengine/move_picker.h"
+
+#include <chesscore/fen.h>
+
+using namespace chessengine;
+using namespace chesscore;
+
+namespace {
+
+const Position test_position{FenString{"4k2r/7p/8/3q4/4P2Q/8/8/3RK3 w - - 0 1"}};
+
+auto collect(MovePicker &picker) -> std::vector<std::pair<Move, MovePicker::Stage>> {
+    std::vector<std::pair<Move, MovePicker::Stage>> moves;
+    while (const auto move = picker.next()) {
+        moves.emplace_back(move.value(), picker.stage());
+    }
+    return moves;
+}
+
+} // namespace
+
+TEST_CASE("MovePicker.Stages", "[move_picker]") {
+    const Evaluator evaluator{};
+    const Move hash_move{.from = Square::E1, .to = Square::F2, .piece = Piece::WhiteKing};
+    const EnginePosition position{test_position};
+    const MoveGenerator generator{position};
+    MovePicker::MoveBuffer buffer{};
+    MovePicker picker{buffer, generator, evaluator, PackedMove{hash_move}};
+    const auto moves = collect(picker);
+
+    REQUIRE(moves.size() == test_position.all_legal_moves().size());
+    CHECK(PackedMove{hash_move}.matches(moves[0].first));
+    CHECK(moves[0].second == MovePicker::Stage::HashMove);
+    CHECK(moves[1].first.from == Square::E4);
+    CHECK(moves[1].first.to == Square::D5);
+    CHECK(moves[1].second == MovePicker::Stage::GoodCaptures);
+    CHECK(moves[2].first.from == Square::D1);
+    CHECK(moves[2].first.to == Square::D5);
+    CHECK(moves[2].second == MovePicker::Stage::GoodCaptures);
+    CHECK(moves.back().first.to == Square::H7);
+    CHECK(moves.back().second == MovePicker::Stage::LosingCaptures);
+    for (std::size_t index = 3; index + 1 < moves.size(); ++index) {
+        CHECK(moves[index].second == MovePicker::Stage::Quiets);
+    }
+}
+
+TEST_CASE("MovePicker.Killers", "[move_picker]") {
+    const Evaluator evaluator{};
+    const Move killer{.from = Square::H4, .to = Square::D8, .piece = Piece::WhiteQueen};
+    const PackedMove killers[]{PackedMove{killer}};
+    const EnginePosition position{test_position};
+    const MoveGenerator generator{position};
+    MovePicker::MoveBuffer buffer{};
+    MovePicker picker{buffer, generator, evaluator, PackedMove{}, MoveOrderingHints{.killers = killers}};
+    const auto moves = collect(picker);
+
+    REQUIRE(moves.size() > 2);
+    CHECK(PackedMove{killer}.matches(moves[2].first));
+    CHECK(moves[2].second == MovePicker::Stage::Killers);
+}
+
+TEST_CASE("MovePicker.Captures", "[move_picker]") {
+    const Evaluator evaluator{};
+    const EnginePosition position{test_position};
+    const MoveGenerator generator{position};
+    MovePicker::MoveBuffer buffer{};
+    auto picker = MovePicker::captures(buffer, generator, evaluator);
+    const auto moves = collect(picker);
+
+    REQUIRE(moves.size() == 3);
+    CHECK(moves[0].first.from == Square::E4);
+    CHECK(moves[1].first.from == Square::D1);
+    CHECK(moves[2].first.from == Square::H4);
+}
+
+TEST_CASE("MovePicker.Without ordering", "[move_picker]") {
+    const Evaluator evaluator{};
+    const EnginePosition position{test_position};
+    const MoveGenerator generator{position};
+    GeneratedMoves legal_moves;
+    generator.generate_legal_moves(legal_moves);
+    MovePicker::MoveBuffer buffer{};
+    MovePicker picker{buffer, generator, evaluator, PackedMove{legal_moves[legal_moves.size() - 1]}, {}, false};
+    const auto moves = collect(picker);
+
+    REQUIRE(moves.size() == legal_moves.size());
+    for (std::size_t index = 0; index < moves.size(); ++index) {
+        CHECK(moves[index].first == legal_moves[index]);
+    }
+}
@@ -0,0 +1,40 @@
+/* ************************************************************************** *
+ * Chess Engine                                                               *
+ * Chess playing engine                                                       *
+ * ************************************************************************** */
+
+#include <catch2/catch_all.hpp>
+
+#include "chessengine/pawn_hash_table.h"
+
+using namespace chessengine;
+
+TEST_CASE("PawnHashTable.Entry", "[pawn_hash_table]") {
+    PawnHashTable table{1024};
+    const HashKey key{0x123456789ABCDEF0ULL};
+    auto &entry = table.entry(key);
+    CHECK(entry.key == 0);
+    CHECK(entry.king_squares[0] == PawnEntry::no_square);
+
+    entry.key = key;
+    entry.middlegame = Score{-17};
+    entry.endgame = Score{23};
+    CHECK(table.entry(key).key == key);
+    CHECK(table.entry(key).middlegame == Score{-17});
+    CHECK(table.entry(key).endgame == Score{23});
+    CHECK(&table.entry(key + 1024) == &entry);
+    CHECK(&table.entry(key + 1) != &entry);
+}
+
+TEST_CASE("PawnHashTable.Clear", "[pawn_hash_table]") {
+    PawnHashTable table{16};
+    const HashKey key{42};
+    table.entry(key).key = key;
+    table.clear();
+    CHECK(table.entry(key).key == 0);
+}
+
+TEST_CASE("PawnHashTable.Size is a power of two", "[pawn_hash_table]") {
+    PawnHashTable table{1000};
+    CHECK(&table.entry(0) == &table.entry(512));
+}
@@ -0,0 +1,40 @@
+/* ************************************************************************** *
+ * Chess Engine                                                               *
+ * Chess playing engine                                                       *
+ * ************************************************************************** */
+
+#include <catch2/catch_all.hpp>
+
+#include "chessengine/perft.h"
+
+#include <chesscore/fen.h>
+
+using namespace chessengine;
+using namespace chesscore;
+
+TEST_CASE("Perft.Counts", "[perft]") {
+    Perft perft{};
+    const auto result = perft.run(Position::start_position(), 3);
+    CHECK(result.depth == 3);
+    CHECK(result.nodes == 8902);
+    CHECK(result.root_moves.size() == 20);
+    CHECK(perft.run(Position::start_position(), 1).nodes == 20);
+    CHECK(perft.run(Position::start_position(), 0).nodes == 1);
+}
+
+TEST_CASE("Perft.Threads and cache", "[perft]") {
+    const Position position{FenString{"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1"}};
+    const auto reference = Perft{}.run(position, 3);
+    CHECK(reference.nodes == 97862);
+
+    Perft perft{PerftConfig{.threads = 4, .hash_size_mb = 1}};
+    // The second run takes the counts from the cache.
+    for (int run = 0; run < 2; ++run) {
+        const auto result = perft.run(position, 3);
+        CHECK(result.nodes == reference.nodes);
+        REQUIRE(result.root_moves.size() == reference.root_moves.size());
+        for (std::size_t index = 0; index < result.root_moves.size(); ++index) {
+            CHECK(result.root_moves[index].second == reference.root_moves[index].second);
+        }
+    }
+}
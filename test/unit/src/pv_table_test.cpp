@@ -0,0 +1,54 @@
+/* ************************************************************************** *
+ * Chess Engine                                                               *
+ * Chess playing engine                                                       *
+ * ************************************************************************** */
+
+#include <catch2/catch_all.hpp>
+
+#include "chessengine/pv_table.h"
+
+using namespace chessengine;
+using namespace chesscore;
+
+TEST_CASE("PVTable.Collect line", "[pv_table]") {
+    const Move move1{.from = Square::E2, .to = Square::E4, .piece = Piece::WhitePawn};
+    const Move move2{.from = Square::E7, .to = Square::E5, .piece = Piece::BlackPawn};
+    const Move move3{.from = Square::G1, .to = Square::F3, .piece = Piece::WhiteKnight};
+
+    PVTable table;
+    table.clear(0);
+    table.clear(1);
+    table.clear(2);
+    table.clear(3);
+    table.update(2, move3);
+    table.update(1, move2);
+    table.update(0, move1);
+
+    const auto line = table.line();
+    REQUIRE(line.size() == 3);
+    CHECK(line[0] == move1);
+    CHECK(line[1] == move2);
+    CHECK(line[2] == move3);
+    CHECK(table.line(1).size() == 2);
+}
+
+TEST_CASE("PVTable.New best move replaces line", "[pv_table]") {
+    const Move move1{.from = Square::E2, .to = Square::E4, .piece = Piece::WhitePawn};
+    const Move move2{.from = Square::E7, .to = Square::E5, .piece = Piece::BlackPawn};
+    const Move move3{.from = Square::D2, .to = Square::D4, .piece = Piece::WhitePawn};
+
+    PVTable table;
+    table.clear(0);
+    table.clear(1);
+    table.clear(2);
+    table.update(1, move2);
+    table.update(0, move1);
+    REQUIRE(table.line().size() == 2);
+
+    // The child of the next move ends without a line (e.g. at the horizon)
+    table.clear(1);
+    table.update(0, move3);
+    const auto line = table.line();
+    REQUIRE(line.size() == 1);
+    CHECK(line[0] == move3);
+}
@@ -6,9 +6,103 @@
 #include <catch2/catch_all.hpp>
 
 #include "chessengine/types.h"
+
+#include <vector>
+
 using namespace chessengine;
 
 TEST_CASE("Score.Mate in X", "[score]") {
     CHECK(ply_to_mate(Score::Mate - Depth{3}) == Depth{3});
     CHECK(ply_to_mate(-(Score::Mate - Depth{5})) == Depth{5});
 }
+
+TEST_CASE("Score.Proven mate", "[score]") {
+    CHECK(is_proven_mate(Score::Mate - Depth{3}, Depth{3}));
+    CHECK(is_proven_mate(Score::Mate - Depth{3}, Depth{4}));
+    CHECK_FALSE(is_proven_mate(Score::Mate - Depth{3}, Depth{2}));
+    CHECK(is_proven_mate(-(Score::Mate - Depth{4}), Depth{4}));
+    CHECK_FALSE(is_proven_mate(-(Score::Mate - Depth{4}), Depth{3}));
+    CHECK_FALSE(is_proven_mate(Score{0}, Depth{3}));
+    CHECK_FALSE(is_proven_mate(Score{500}, Depth::Infinite));
+    CHECK_FALSE(is_proven_mate(-Score{500}, Depth::Infinite));
+}
+
+TEST_CASE("Score.Adjust mate distance", "[score]") {
+    CHECK(adjust_mate_distance(Score::Mate) == Score::Mate - Depth{1});
+    CHECK(adjust_mate_distance(Score::Mate - Depth{3}) == Score::Mate - Depth{4});
+    CHECK(adjust_mate_distance(-Score::Mate) == -(Score::Mate - Depth{1}));
+    CHECK(adjust_mate_distance(-(Score::Mate - Depth{3})) == -(Score::Mate - Depth{4}));
+    CHECK(adjust_mate_distance(Score{0}) == Score{0});
+    CHECK(adjust_mate_distance(Score{500}) == Score{500});
+    CHECK(adjust_mate_distance(-Score{500}) == -Score{500});
+}
+
+TEST_CASE("Score.Child bounds", "[score]") {
+    SECTION("Infinite bounds stay infinite") {
+        const auto child = child_bounds(Bounds{});
+        CHECK(child.alpha == Score::NegInfinity);
+        CHECK(child.beta == Score::Infinity);
+    }
+    SECTION("Normal bounds are swapped") {
+        const auto child = child_bounds(Bounds{Score{-20}, Score{50}});
+        CHECK(child.alpha == Score{-50});
+        CHECK(child.beta == Score{20});
+    }
+    SECTION("Mate bounds are one ply closer to the mate") {
+        const auto child = child_bounds(Bounds{-Score::Mate, Score::Mate});
+        CHECK(child.alpha == -(Score::Mate + Depth{1}));
+        CHECK(child.beta == Score::Mate + Depth{1});
+        const auto mate_in_3 = child_bounds(Bounds{Score::Mate - Depth{3}, Score::Infinity});
+        CHECK(mate_in_3.alpha == Score::NegInfinity);
+        CHECK(mate_in_3.beta == -(Score::Mate - Depth{2}));
+    }
+    SECTION("Bounds at the edge of the mate range") {
+        const Score mate_threshold = Score::Mate - Depth::MaxMateDepth;
+        const auto below_mate = child_bounds(Bounds{mate_threshold - Depth{1}, Score::Infinity});
+        CHECK(below_mate.beta == -mate_threshold);
+        const auto above_mated = child_bounds(Bounds{Score::NegInfinity, -(mate_threshold - Depth{1})});
+        CHECK(above_mated.alpha == mate_threshold);
+    }
+}
+
+TEST_CASE("Score.Child bounds are the inverse of adjust mate distance", "[score]") {
+    // A child score lies above (below) the lower (upper) bound of the child
+    // window, if and only if the adjusted score lies below (above) the upper
+    // (lower) bound of the parent window.
+    const Score mate_threshold = Score::Mate - Depth::MaxMateDepth;
+    std::vector<Score> scores{Score{0}, Score{1}, -Score{1}, Score{500}, -Score{500}};
+    for (auto score = mate_threshold - Depth{2}; score <= Score::Mate; score += Score{1}) {
+        scores.push_back(score);
+        scores.push_back(-score);
+    }
+    const std::vector<Score> bounds{Score::NegInfinity,
+                                    -Score::Mate,
+                                    -(Score::Mate - Depth{1}),
+                                    -(Score::Mate - Depth{5}),
+                                    -mate_threshold,
+                                    -(mate_threshold - Depth{1}),
+                                    -Score{500},
+                                    Score{0},
+                                    Score{500},
+                                    mate_threshold - Depth{1},
+                                    mate_threshold,
+                                    Score::Mate - Depth{5},
+                                    Score::Mate - Depth{1},
+                                    Score::Mate,
+                                    Score::Infinity};
+    for (const auto alpha : bounds) {
+        for (const auto beta : bounds) {
+            if (alpha >= beta) {
+                continue;
+            }
+            const Bounds parent{alpha, beta};
+            const auto child = child_bounds(parent);
+            for (const auto score : scores) {
+                const auto adjusted = adjust_mate_distance(-score);
+                if ((score > child.alpha) != (adjusted < parent.beta) || (score < child.beta) != (adjusted > parent.alpha)) {
+                    FAIL("score " << score << " in window [" << parent.alpha << ", " << parent.beta << "]");
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,61 @@
+/* ************************************************************************** *
+ * Chess Engine                                                               *
+ * Chess playing engine                                                       *
+ * ************************************************************************** */
+
+#include <catch2/catch_all.hpp>
+
+#include "chessengine/evaluation.h"
+
+#include <chesscore/fen.h>
+
+using namespace chessengine;
+using namespace chesscore;
+
+namespace {
+
+auto see(const std::string &fen, const Square &from, const Square &to) -> Score {
+    const Evaluator evaluator{};
+    const Position position{FenString{fen}};
+    for (const auto &move : position.all_legal_moves()) {
+        if (move.from == from && move.to == to) {
+            return evaluator.see(position, move);
+        }
+    }
+    throw std::runtime_error{"move not found"};
+}
+
+} // namespace
+
+TEST_CASE("SEE.Undefended piece", "[see]") {
+    CHECK(see("4k3/8/8/3p4/8/8/8/3RK3 w - - 0 1", Square::D1, Square::D5) == Score{100});
+}
+
+TEST_CASE("SEE.Queen takes defended pawn", "[see]") {
+    CHECK(see("4k3/8/2p5/3p4/8/8/8/3QK3 w - - 0 1", Square::D1, Square::D5) == Score{-800});
+}
+
+TEST_CASE("SEE.Pawn takes defended queen", "[see]") {
+    CHECK(see("4k3/8/2p5/3q4/4P3/8/8/4K3 w - - 0 1", Square::E4, Square::D5) == Score{900});
+}
+
+TEST_CASE("SEE.X-ray", "[see]") {
+    // The second rook attacks through the first one.
+    CHECK(see("3rk3/8/8/3p4/8/8/3R4/3RK3 w - - 0 1", Square::D2, Square::D5) == Score{100});
+    CHECK(see("3rk3/3r4/8/3p4/8/8/3R4/3RK3 w - - 0 1", Square::D2, Square::D5) == Score{-400});
+}
+
+TEST_CASE("SEE.King does not capture defended piece", "[see]") {
+    CHECK(see("3k4/3p4/8/8/8/8/8/3RK3 w - - 0 1", Square::D1, Square::D7) == Score{-400});
+    CHECK(see("3k4/3p4/8/1B6/8/8/8/3RK3 w - - 0 1", Square::D1, Square::D7) == Score{100});
+}
+
+TEST_CASE("SEE.Promotion", "[see]") {
+    const Evaluator evaluator{};
+    const Position position{FenString{"4k3/1P6/8/8/8/8/8/4K3 w - - 0 1"}};
+    for (const auto &move : position.all_legal_moves()) {
+        if (move.promoted.has_value() && move.promoted->type() == PieceType::Queen) {
+            CHECK(evaluator.see(position, move) == Score{800});
+        }
+    }
+}
@@ -0,0 +1,83 @@
+/* ************************************************************************** *
+ * Chess Engine                                                               *
+ * Chess playing engine                                                       *
+ * ************************************************************************** */
+
+#include <catch2/catch_all.hpp>
+
+#include "chessengine/transposition_table.h"
+
+using namespace chessengine;
+using namespace chesscore;
+
+TEST_CASE("TranspositionTable.PackedMove", "[transposition_table]") {
+    const Move move{.from = Square::E2, .to = Square::E4, .piece = Piece::WhitePawn};
+    const Move other{.from = Square::E2, .to = Square::E3, .piece = Piece::WhitePawn};
+    const PackedMove packed{move};
+    CHECK_FALSE(packed.empty());
+    CHECK(packed.matches(move));
+    CHECK_FALSE(packed.matches(other));
+    CHECK(PackedMove{}.empty());
+    CHECK_FALSE(PackedMove{}.matches(move));
+}
+
+TEST_CASE("TranspositionTable.PackedMove.Promotion", "[transposition_table]") {
+    Move queen{.from = Square::E7, .to = Square::E8, .piece = Piece::WhitePawn};
+    queen.promoted = Piece::WhiteQueen;
+    Move knight{.from = Square::E7, .to = Square::E8, .piece = Piece::WhitePawn};
+    knight.promoted = Piece::WhiteKnight;
+    CHECK(PackedMove{queen}.matches(queen));
+    CHECK_FALSE(PackedMove{queen}.matches(knight));
+}
+
+TEST_CASE("TranspositionTable.Store and probe", "[transposition_table]") {
+    TranspositionTable table{1};
+    const HashKey key{0x123456789ABCDEF0ULL};
+    const Move move{.from = Square::G1, .to = Square::F3, .piece = Piece::WhiteKnight};
+    CHECK_FALSE(table.probe(key).has_value());
+
+    table.store(key, TranspositionEntry{.move = PackedMove{move}, .score = Score{-42}, .depth = Depth{5}, .bound = ScoreBound::Lower});
+    const auto entry = table.probe(key);
+    REQUIRE(entry.has_value());
+    CHECK(entry->move.matches(move));
+    CHECK(entry->score == Score{-42});
+    CHECK(entry->depth == Depth{5});
+    CHECK(entry->bound == ScoreBound::Lower);
+    CHECK_FALSE(table.probe(key ^ 1U).has_value());
+}
+
+TEST_CASE("TranspositionTable.Mate scores", "[transposition_table]") {
+    TranspositionTable table{1};
+    table.store(1U, TranspositionEntry{.move = {}, .score = Score::Mate - Depth{3}, .depth = Depth{4}, .bound = ScoreBound::Exact});
+    table.store(2U, TranspositionEntry{.move = {}, .score = -(Score::Mate - Depth{6}), .depth = Depth{7}, .bound = ScoreBound::Exact});
+    CHECK(table.probe(1U)->score == Score::Mate - Depth{3});
+    CHECK(table.probe(2U)->score == -(Score::Mate - Depth{6}));
+}
+
+TEST_CASE("TranspositionTable.Keep move", "[transposition_table]") {
+    TranspositionTable table{1};
+    const HashKey key{42};
+    const Move move{.from = Square::G1, .to = Square::F3, .piece = Piece::WhiteKnight};
+    table.store(key, TranspositionEntry{.move = PackedMove{move}, .score = Score{10}, .depth = Depth{2}, .bound = ScoreBound::Exact});
+    table.store(key, TranspositionEntry{.move = {}, .score = Score{-10}, .depth = Depth{3}, .bound = ScoreBound::Upper});
+    const auto entry = table.probe(key);
+    REQUIRE(entry.has_value());
+    CHECK(entry->move.matches(move));
+    CHECK(entry->bound == ScoreBound::Upper);
+}
+
+TEST_CASE("TranspositionTable.Clear", "[transposition_table]") {
+    TranspositionTable table{1};
+    table.store(7U, TranspositionEntry{.move = {}, .score = Score{0}, .depth = Depth{1}, .bound = ScoreBound::Exact});
+    REQUIRE(table.probe(7U).has_value());
+    table.clear();
+    CHECK_FALSE(table.probe(7U).has_value());
+}
+
+TEST_CASE("TranspositionTable.Resize", "[transposition_table]") {
+    TranspositionTable table{1};
+    table.resize(2);
+    CHECK(table.size_mb() == 2);
+    table.store(7U, TranspositionEntry{.move = {}, .score = Score{0}, .depth = Depth{1}, .bound = ScoreBound::Exact});
+    CHECK(table.probe(7U).has_value());
+}
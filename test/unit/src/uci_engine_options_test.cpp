@@ -0,0 +1,75 @@
+/* ************************************************************************** *
+ * Chess Engine                                                               *
+ * Chess playing engine                                                       *
+ * ************************************************************************** */
+
+#include <catch2/catch_all.hpp>
+
+#include "chessengine/test_engine.h"
+#include "chessengine/uci_adapter.h"
+
+using namespace chessengine;
+
+namespace {
+
+auto setoption(const std::string &name, const std::string &value) -> chessuci::setoption_command {
+    chessuci::setoption_command command{};
+    command.name = name;
+    command.value = value;
+    return command;
+}
+
+} // namespace
+
+TEST_CASE("UCIEngine.Options.Hash", "[uci_engine]") {
+    auto uci_engine = UCIAdapter<TestEngine>{};
+    uci_engine.set_option_callback(setoption("Hash", "64"));
+    CHECK(uci_engine.engine().config().search_config.hash_size_mb == 64);
+}
+
+TEST_CASE("UCIEngine.Options.Hash clamped", "[uci_engine]") {
+    auto uci_engine = UCIAdapter<TestEngine>{};
+    uci_engine.set_option_callback(setoption("Hash", "0"));
+    CHECK(uci_engine.engine().config().search_config.hash_size_mb == 1);
+}
+
+TEST_CASE("UCIEngine.Options.EvalCache", "[uci_engine]") {
+    auto uci_engine = UCIAdapter<TestEngine>{};
+    uci_engine.set_option_callback(setoption("EvalCache", "8"));
+    CHECK(uci_engine.engine().config().search_config.eval_cache_size_mb == 8);
+    uci_engine.set_option_callback(setoption("EvalCache", "1000"));
+    CHECK(uci_engine.engine().config().search_config.eval_cache_size_mb == 256);
+    CHECK(uci_engine.engine().config().search_config.hash_size_mb == SearchConfig{}.hash_size_mb);
+}
+
+TEST_CASE("UCIEngine.Options.EvalCache off", "[uci_engine]") {
+    auto uci_engine = UCIAdapter<TestEngine>{};
+    uci_engine.set_option_callback(setoption("EvalCache", "0"));
+    CHECK(uci_engine.engine().config().search_config.eval_cache_size_mb == 0);
+}
+
+TEST_CASE("UCIEngine.Options.Threads", "[uci_engine]") {
+    auto uci_engine = UCIAdapter<TestEngine>{};
+    uci_engine.set_option_callback(setoption("Threads", "8"));
+    CHECK(uci_engine.engine().config().search_config.threads == 8);
+    uci_engine.set_option_callback(setoption("Threads", "0"));
+    CHECK(uci_engine.engine().config().search_config.threads == 1);
+}
+
+TEST_CASE("UCIEngine.Options.Invalid value", "[uci_engine]") {
+    auto uci_engine = UCIAdapter<TestEngine>{};
+    const auto search_config = uci_engine.engine().config().search_config;
+    uci_engine.set_option_callback(setoption("Hash", "lots"));
+    uci_engine.set_option_callback(setoption("Threads", "-2"));
+    uci_engine.set_option_callback(setoption("EvalCache", "8 MB"));
+    CHECK(uci_engine.engine().config().search_config.hash_size_mb == search_config.hash_size_mb);
+    CHECK(uci_engine.engine().config().search_config.threads == search_config.threads);
+    CHECK(uci_engine.engine().config().search_config.eval_cache_size_mb == search_config.eval_cache_size_mb);
+}
+
+TEST_CASE("UCIEngine.Options.Unknown option", "[uci_engine]") {
+    auto uci_engine = UCIAdapter<TestEngine>{};
+    const auto hash_size = uci_engine.engine().config().search_config.hash_size_mb;
+    uci_engine.set_option_callback(setoption("Unknown", "1"));
+    CHECK(uci_engine.engine().config().search_config.hash_size_mb == hash_size);
+}
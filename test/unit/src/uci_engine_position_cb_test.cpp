@@ -113,7 +113,7 @@ TEST_CASE("UCIEngine.Position.Jump Back", "[uci_engine]") {
     std::ranges::for_each(test_case.position_commands, [&](const auto &cmd) -> void { uci_engine.position_callback(cmd); });
     uci_engine.position_callback(test_case.position_commands[1]);
     const auto &log = test_engine.call_log();
-    REQUIRE(log.size() == 8);
+    REQUIRE(log.size() == 9);
     CHECK(std::holds_alternative<TestEngine::set_position_call>(log[0]));
     CHECK(std::get<TestEngine::set_position_call>(log[0]).position == test_case.positions[0]);
     CHECK(std::holds_alternative<TestEngine::position_call>(log[1]));
@@ -126,7 +126,9 @@ TEST_CASE("UCIEngine.Position.Jump Back", "[uci_engine]") {
     CHECK(std::holds_alternative<TestEngine::play_move_call>(log[6]));
     CHECK(std::get<TestEngine::play_move_call>(log[6]).move == test_case.moves[2]);
     CHECK(std::holds_alternative<TestEngine::set_position_call>(log[7]));
-    CHECK(std::get<TestEngine::set_position_call>(log[7]).position == test_case.positions[1]);
+    CHECK(std::get<TestEngine::set_position_call>(log[7]).position == test_case.positions[0]);
+    CHECK(std::holds_alternative<TestEngine::play_move_call>(log[8]));
+    CHECK(std::get<TestEngine::play_move_call>(log[8]).move == test_case.moves[0]);
 }
 
 TEST_CASE("UCIEngine.Position.Switch Line", "[uci_engine]") {
@@ -145,7 +147,7 @@ TEST_CASE("UCIEngine.Position.Switch Line", "[uci_engine]") {
     uci_engine.position_callback(test_case2.position_commands[3]);
 
     const auto &log = test_engine.call_log();
-    REQUIRE(log.size() == 8);
+    REQUIRE(log.size() == 11);
     CHECK(std::holds_alternative<TestEngine::set_position_call>(log[0]));
     CHECK(std::get<TestEngine::set_position_call>(log[0]).position == test_case1.positions[0]);
     CHECK(std::holds_alternative<TestEngine::position_call>(log[1]));
@@ -158,5 +160,11 @@ TEST_CASE("UCIEngine.Position.Switch Line", "[uci_engine]") {
     CHECK(std::holds_alternative<TestEngine::play_move_call>(log[6]));
     CHECK(std::get<TestEngine::play_move_call>(log[6]).move == test_case1.moves[2]);
     CHECK(std::holds_alternative<TestEngine::set_position_call>(log[7]));
-    CHECK(std::get<TestEngine::set_position_call>(log[7]).position == test_case2.positions[3]);
+    CHECK(std::get<TestEngine::set_position_call>(log[7]).position == test_case2.positions[0]);
+    CHECK(std::holds_alternative<TestEngine::play_move_call>(log[8]));
+    CHECK(std::get<TestEngine::play_move_call>(log[8]).move == test_case2.moves[0]);
+    CHECK(std::holds_alternative<TestEngine::play_move_call>(log[9]));
+    CHECK(std::get<TestEngine::play_move_call>(log[9]).move == test_case2.moves[1]);
+    CHECK(std::holds_alternative<TestEngine::play_move_call>(log[10]));
+    CHECK(std::get<TestEngine::play_move_call>(log[10]).move == test_case2.moves[2]);
 }